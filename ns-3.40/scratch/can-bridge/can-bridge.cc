@@ -0,0 +1,402 @@
+/*
+ * Linux SocketCAN(vcan) <-> LR-WPAN 실시간 브리지
+ *
+ * RealtimeSimulatorImpl로 시뮬레이션을 wall-clock에 맞춰 진행하면서
+ *  1. 읽기 스레드가 rxIface(vcan0)에서 recvmmsg()로 CAN 프레임을 묶음 단위로 읽고,
+ *  2. CAN ID마다 지정된 디바이스가 게이트웨이(코디네이터, 00:01)에게 MCPS-DATA.request로 전송하며,
+ *  3. 게이트웨이의 MCPS-DATA.indication에서 원래 CAN 프레임을 복원해 txIface(vcan1)로 씁니다.
+ * 종료 시 CAN ID별 브리지 지연(vcan 수신 -> vcan 송신, wall-clock)과 지터 히스토그램,
+ * 버스 주기 deadline을 넘긴 프레임 수를 출력합니다.
+ *
+ * 준비:
+ *   sudo modprobe vcan
+ *   sudo ip link add dev vcan0 type vcan && sudo ip link set up vcan0
+ *   sudo ip link add dev vcan1 type vcan && sudo ip link set up vcan1
+ *
+ * 사용 예:
+ *   ./ns3 run "can-bridge --map=0x100:1,0x200:2,0x300:3 --deadline=10000 --duration=60"
+ *   cangen vcan0 -I 100 -g 10 &  candump vcan1
+ */
+#include "socket-can-port.h"
+
+#include <ns3/core-module.h>
+#include <ns3/lr-wpan-module.h>
+#include <ns3/mobility-module.h>
+#include <ns3/network-module.h>
+#include <ns3/simulator.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using namespace ns3;
+
+const int COORDINATOR_PAN_ID = 5;
+
+
+/////////////////////////// TAG ///////////////////////////
+
+/// @brief vcan에서 프레임을 읽은 wall-clock 시각을 패킷에 실어 보내는 태그
+class BridgeTimestampTag : public Tag
+{
+  public:
+    static TypeId GetTypeId()
+    {
+        static TypeId tid = TypeId("BridgeTimestampTag")
+                                .SetParent<Tag>()
+                                .AddConstructor<BridgeTimestampTag>();
+        return tid;
+    }
+
+    TypeId GetInstanceTypeId() const override
+    {
+        return GetTypeId();
+    }
+
+    uint32_t GetSerializedSize() const override
+    {
+        return sizeof(int64_t);
+    }
+
+    void Serialize(TagBuffer i) const override
+    {
+        i.WriteU64(static_cast<uint64_t>(m_wallNs));
+    }
+
+    void Deserialize(TagBuffer i) override
+    {
+        m_wallNs = static_cast<int64_t>(i.ReadU64());
+    }
+
+    void Print(std::ostream& os) const override
+    {
+        os << "wallNs=" << m_wallNs;
+    }
+
+    int64_t m_wallNs = 0;
+};
+
+NS_OBJECT_ENSURE_REGISTERED(BridgeTimestampTag);
+
+
+/////////////////////////// STATISTICS ///////////////////////////
+
+/// @brief 마이크로초 단위 지연 히스토그램, 2의 거듭제곱 경계 버킷과 백분위 계산용 표본을 함께 유지
+class LatencyHistogram
+{
+  public:
+    void Add(uint64_t us)
+    {
+        uint32_t bucket = 0;
+        while(bucket + 1 < m_buckets.size() && (uint64_t(1) << (bucket + 1)) <= us)
+            bucket++;
+        m_buckets[bucket]++;
+        m_samples.push_back(us);
+    }
+
+    uint64_t Percentile(double p)
+    {
+        if(m_samples.empty())
+            return 0;
+        size_t idx = std::min(m_samples.size() - 1, static_cast<size_t>(p * m_samples.size()));
+        std::nth_element(m_samples.begin(), m_samples.begin() + idx, m_samples.end());
+        return m_samples[idx];
+    }
+
+    void Print(std::ostream& os, const std::string& title)
+    {
+        os << "  " << title << ": n=" << m_samples.size()
+           << " p50=" << Percentile(0.5) << "us"
+           << " p99=" << Percentile(0.99) << "us"
+           << " max=" << Percentile(1.0) << "us" << std::endl;
+
+        uint32_t maxCount = *std::max_element(m_buckets.begin(), m_buckets.end());
+        for(uint32_t i = 0; i < m_buckets.size(); i++)
+        {
+            if(m_buckets[i] == 0)
+                continue;
+            uint32_t bar = maxCount ? 40 * m_buckets[i] / maxCount : 0;
+            os << "    [" << std::setw(8) << (i == 0 ? 0 : (uint64_t(1) << i)) << ", "
+               << std::setw(8) << (uint64_t(1) << (i + 1)) << ") us "
+               << std::setw(8) << m_buckets[i] << " " << std::string(bar, '#') << std::endl;
+        }
+    }
+
+  private:
+    std::vector<uint32_t> m_buckets = std::vector<uint32_t>(32, 0);
+    std::vector<uint64_t> m_samples;
+};
+
+
+/// @brief CAN ID 하나의 브리지 통계
+struct CanIdStats
+{
+    LatencyHistogram latency;
+    LatencyHistogram jitter;        ///< 연속한 두 프레임의 지연 차이
+    int64_t lastLatencyUs = -1;
+    uint32_t sent = 0;
+    uint32_t delivered = 0;
+    uint32_t deadlineMisses = 0;
+};
+
+
+/////////////////////////// BRIDGE ///////////////////////////
+
+/// CAN ID -> 송신 디바이스 인덱스 (1부터, 0은 게이트웨이)
+static std::map<canid_t, uint32_t> g_canIdMap;
+static bool g_mapUnknown = true;
+static uint64_t g_deadlineUs = 0;
+
+static NetDeviceContainer g_netDevices;
+static std::vector<Ptr<LrWpanMac>> g_macs;          ///< 디바이스 인덱스 -> MAC
+static std::vector<uint32_t> g_nodeIds;             ///< 디바이스 인덱스 -> 노드 ID (이벤트 context)
+static std::unique_ptr<SocketCanPort> g_txPort;
+static std::map<canid_t, CanIdStats> g_stats;
+static std::atomic<bool> g_stop {false};
+static std::atomic<uint64_t> g_batches {0};
+
+
+/// @brief CAN ID를 보낼 디바이스 인덱스, 매핑은 시작 후 바뀌지 않으므로 읽기 스레드에서도 호출할 수 있습니다.
+/// @param canId CAN ID (플래그 제외)
+/// @return 디바이스 인덱스, 보내지 않을 프레임이면 0
+static uint32_t
+DeviceIndex(canid_t canId)
+{
+    auto it = g_canIdMap.find(canId);
+    if(it != g_canIdMap.end())
+        return it->second;
+    if(g_mapUnknown)
+        return canId % (g_macs.size() - 1) + 1;
+    return 0;
+}
+
+
+/// @brief 읽기 스레드가 넘겨준 묶음 중 디바이스 하나의 프레임을 MCPS-DATA.request로 변환합니다.
+/// 시뮬레이터 스레드에서 해당 디바이스 노드의 context로 실행됩니다.
+/// @param batch recvmmsg() 버퍼 그대로의 묶음, tags에 프레임별 디바이스 인덱스
+/// @param device 디바이스 인덱스
+static void
+InjectBatch(const std::shared_ptr<const CanFrameBatch>& batch, uint32_t device)
+{
+    static uint8_t msduHandle = 0;
+
+    for(uint32_t i = 0; i < batch->count; i++)
+    {
+        if(batch->tags[i] != device)
+            continue;
+
+        const struct can_frame& frame = batch->frames[i];
+        canid_t canId = frame.can_id & CAN_EFF_MASK;
+
+        // 페이로드: CAN ID(4 byte, 플래그 포함) + 데이터(dlc byte)
+        uint8_t buffer[4 + CAN_MAX_DLEN];
+        uint32_t rawId = frame.can_id;
+        buffer[0] = rawId >> 24;
+        buffer[1] = rawId >> 16;
+        buffer[2] = rawId >> 8;
+        buffer[3] = rawId;
+        uint8_t dlc = std::min<uint8_t>(frame.can_dlc, CAN_MAX_DLEN);
+        std::copy(frame.data, frame.data + dlc, buffer + 4);
+
+        Ptr<Packet> packet = Create<Packet>(buffer, 4 + dlc);
+        BridgeTimestampTag tag;
+        tag.m_wallNs = batch->wallNs;
+        packet->AddPacketTag(tag);
+
+        McpsDataRequestParams params;
+        params.m_dstPanId = COORDINATOR_PAN_ID;
+        params.m_srcAddrMode = SHORT_ADDR;
+        params.m_dstAddrMode = SHORT_ADDR;
+        params.m_dstAddr = Mac16Address("00:01");
+        params.m_msduHandle = msduHandle++;
+        params.m_txOptions = TX_OPTION_ACK;
+
+        g_stats[canId].sent++;
+        g_macs[device]->McpsDataRequest(params, packet);
+    }
+}
+
+
+/// @brief 게이트웨이의 MCPS-DATA.indication 콜백, CAN 프레임을 복원해 vcan으로 쓰고 지연을 기록합니다.
+/// @param params McpsDataIndicationParams
+/// @param p Ptr<Packet>
+static void
+GatewayDataIndication(McpsDataIndicationParams params, Ptr<Packet> p)
+{
+    uint8_t buffer[4 + CAN_MAX_DLEN];
+    uint32_t size = std::min<uint32_t>(p->GetSize(), sizeof(buffer));
+    if(size < 4)
+        return;
+    p->CopyData(buffer, size);
+
+    struct can_frame frame;
+    std::memset(&frame, 0, sizeof(frame));
+    frame.can_id = (uint32_t(buffer[0]) << 24) | (uint32_t(buffer[1]) << 16)
+                   | (uint32_t(buffer[2]) << 8) | buffer[3];
+    frame.can_dlc = size - 4;
+    std::copy(buffer + 4, buffer + size, frame.data);
+
+    g_txPort->Write(frame);
+
+    BridgeTimestampTag tag;
+    if(!p->PeekPacketTag(tag))
+        return;
+
+    CanIdStats& stats = g_stats[frame.can_id & CAN_EFF_MASK];
+    int64_t latencyUs = (SocketCanPort::NowNs() - tag.m_wallNs) / 1000;
+    stats.delivered++;
+    stats.latency.Add(latencyUs);
+    if(stats.lastLatencyUs >= 0)
+        stats.jitter.Add(std::abs(latencyUs - stats.lastLatencyUs));
+    stats.lastLatencyUs = latencyUs;
+    if(g_deadlineUs && static_cast<uint64_t>(latencyUs) > g_deadlineUs)
+        stats.deadlineMisses++;
+}
+
+
+/// @brief vcan 읽기 스레드, 묶음 하나를 읽을 때마다 그 묶음에 프레임이 있는 디바이스별로
+/// 시뮬레이터에 이벤트 하나씩 넘깁니다. 이벤트는 버퍼를 복사하지 않고 shared_ptr만 공유합니다.
+/// RealtimeSimulatorImpl의 ScheduleWithContext는 다른 스레드에서 호출해도 안전합니다.
+/// @param port 수신 포트
+static void
+ReaderLoop(SocketCanPort* port)
+{
+    std::vector<uint32_t> devices;
+    while(!g_stop.load())
+    {
+        std::shared_ptr<CanFrameBatch> batch = port->ReadBatch();
+        if(!batch)
+            continue;
+
+        devices.clear();
+        for(uint32_t i = 0; i < batch->count; i++)
+        {
+            uint32_t device = DeviceIndex(batch->frames[i].can_id & CAN_EFF_MASK);
+            batch->tags[i] = device;
+            if(device != 0 && std::find(devices.begin(), devices.end(), device) == devices.end())
+                devices.push_back(device);
+        }
+
+        g_batches++;
+        std::shared_ptr<const CanFrameBatch> shared = std::move(batch);
+        for(uint32_t device : devices)
+            Simulator::ScheduleWithContext(g_nodeIds[device], Seconds(0), &InjectBatch, shared, device);
+    }
+}
+
+
+/// @brief "0x100:1,0x200:2" 형식의 매핑을 읽습니다.
+/// @param map 매핑 문자열
+/// @return 가장 큰 디바이스 인덱스
+static uint32_t
+ParseCanIdMap(const std::string& map)
+{
+    uint32_t maxIndex = 0;
+    std::stringstream ss(map);
+    std::string entry;
+    while(std::getline(ss, entry, ','))
+    {
+        size_t colon = entry.find(':');
+        NS_ABORT_MSG_IF(colon == std::string::npos, "invalid CAN ID mapping: " << entry);
+        canid_t canId = std::stoul(entry.substr(0, colon), nullptr, 0);
+        uint32_t index = std::stoul(entry.substr(colon + 1));
+        NS_ABORT_MSG_IF(index == 0, "device index 0 is the gateway");
+        g_canIdMap[canId] = index;
+        maxIndex = std::max(maxIndex, index);
+    }
+    return maxIndex;
+}
+
+
+int main(int argc, char* argv[])
+{
+    std::string rxIface = "vcan0";
+    std::string txIface = "vcan1";
+    std::string map;
+    uint32_t deviceCount = 4;
+    uint32_t batchSize = 64;
+    double duration = 60;
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("rxIface", "CAN 프레임을 읽을 인터페이스", rxIface);
+    cmd.AddValue("txIface", "수신한 프레임을 쓸 인터페이스 (rxIface와 같으면 루프가 생김)", txIface);
+    cmd.AddValue("map", "CAN ID -> 디바이스 인덱스 매핑, 예: 0x100:1,0x200:2", map);
+    cmd.AddValue("mapUnknown", "매핑에 없는 CAN ID를 ID % devices 디바이스로 보낼지 여부", g_mapUnknown);
+    cmd.AddValue("devices", "게이트웨이를 제외한 디바이스 수", deviceCount);
+    cmd.AddValue("batch", "recvmmsg() 한 번에 읽을 최대 프레임 수", batchSize);
+    cmd.AddValue("deadline", "버스 주기 deadline (us), 0이면 검사하지 않음", g_deadlineUs);
+    cmd.AddValue("duration", "실행 시간 (s)", duration);
+    cmd.Parse(argc, argv);
+
+    NS_ABORT_MSG_IF(rxIface == txIface, "rxIface and txIface must differ");
+    deviceCount = std::max(deviceCount, ParseCanIdMap(map));
+    NS_ABORT_MSG_IF(deviceCount == 0 && g_mapUnknown, "--mapUnknown needs at least one device (--devices or --map)");
+
+    GlobalValue::Bind("SimulatorImplementationType", StringValue("ns3::RealtimeSimulatorImpl"));
+    GlobalValue::Bind("ChecksumEnabled", BooleanValue(true));
+
+    // 게이트웨이(0번)와 디바이스를 모두 서로의 전파 범위 안에 배치
+    NodeContainer pan;
+    pan.Create(deviceCount + 1);
+
+    MobilityHelper mobilityHelper;
+    mobilityHelper.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+    mobilityHelper.SetPositionAllocator("ns3::GridPositionAllocator",
+                                        "MinX", DoubleValue(0.0),
+                                        "MinY", DoubleValue(0.0),
+                                        "DeltaX", DoubleValue(5.0),
+                                        "DeltaY", DoubleValue(5.0),
+                                        "GridWidth", UintegerValue(5),
+                                        "LayoutType", StringValue("RowFirst"));
+    mobilityHelper.Install(pan);
+
+    LrWpanHelper lrWpanHelper;
+    g_netDevices = lrWpanHelper.Install(pan);
+    lrWpanHelper.CreateAssociatedPan(g_netDevices, COORDINATOR_PAN_ID);
+
+    for(uint32_t i = 0; i < g_netDevices.GetN(); i++)
+    {
+        g_macs.push_back(DynamicCast<LrWpanNetDevice>(g_netDevices.Get(i))->GetMac());
+        g_nodeIds.push_back(g_netDevices.Get(i)->GetNode()->GetId());
+    }
+
+    g_macs[0]->SetMcpsDataIndicationCallback(MakeCallback(&GatewayDataIndication));
+
+    SocketCanPort rxPort(rxIface, batchSize);
+    g_txPort = std::make_unique<SocketCanPort>(txIface);
+
+    std::thread reader(&ReaderLoop, &rxPort);
+
+    Simulator::Stop(Seconds(duration));
+    Simulator::Run();
+
+    g_stop = true;
+    reader.join();
+    Simulator::Destroy();
+
+    std::cout << "bridge " << rxIface << " -> LR-WPAN -> " << txIface
+              << ", " << g_batches.load() << " recvmmsg batches" << std::endl;
+    for(auto& entry : g_stats)
+    {
+        CanIdStats& stats = entry.second;
+        std::cout << "CAN ID 0x" << std::hex << entry.first << std::dec
+                  << ": sent " << stats.sent
+                  << ", delivered " << stats.delivered;
+        if(g_deadlineUs)
+            std::cout << ", deadline misses " << stats.deadlineMisses;
+        std::cout << std::endl;
+
+        stats.latency.Print(std::cout, "latency");
+        stats.jitter.Print(std::cout, "jitter");
+    }
+
+    return 0;
+}
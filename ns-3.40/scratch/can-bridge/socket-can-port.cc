@@ -0,0 +1,137 @@
+#include "socket-can-port.h"
+
+#include <linux/can/raw.h>
+#include <net/if.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+SocketCanPort::SocketCanPort(const std::string& iface, uint32_t batchSize, uint32_t timeoutMs)
+    : m_batchSize(batchSize),
+      m_pool(std::make_shared<BatchPool>())
+{
+    m_fd = socket(PF_CAN, SOCK_RAW, CAN_RAW);
+    if(m_fd < 0)
+    {
+        std::cerr << "socket(PF_CAN) failed: " << std::strerror(errno) << std::endl;
+        std::exit(1);
+    }
+
+    struct ifreq ifr;
+    std::memset(&ifr, 0, sizeof(ifr));
+    std::strncpy(ifr.ifr_name, iface.c_str(), IFNAMSIZ - 1);
+    if(ioctl(m_fd, SIOCGIFINDEX, &ifr) < 0)
+    {
+        std::cerr << "unknown CAN interface " << iface << ": " << std::strerror(errno) << std::endl;
+        std::exit(1);
+    }
+
+    struct sockaddr_can addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.can_family = AF_CAN;
+    addr.can_ifindex = ifr.ifr_ifindex;
+    if(bind(m_fd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) < 0)
+    {
+        std::cerr << "bind(" << iface << ") failed: " << std::strerror(errno) << std::endl;
+        std::exit(1);
+    }
+
+    struct timeval timeout;
+    timeout.tv_sec = timeoutMs / 1000;
+    timeout.tv_usec = (timeoutMs % 1000) * 1000;
+    setsockopt(m_fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+}
+
+
+SocketCanPort::~SocketCanPort()
+{
+    close(m_fd);
+}
+
+
+std::unique_ptr<CanFrameBatch>
+SocketCanPort::AcquireBatch()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_pool->mutex);
+        if(!m_pool->free.empty())
+        {
+            std::unique_ptr<CanFrameBatch> batch = std::move(m_pool->free.back());
+            m_pool->free.pop_back();
+            return batch;
+        }
+    }
+
+    // 커널이 프레임을 frames에 바로 써 넣도록 mmsghdr를 미리 연결
+    auto batch = std::make_unique<CanFrameBatch>();
+    batch->frames.resize(m_batchSize);
+    batch->tags.resize(m_batchSize);
+    batch->iovecs.resize(m_batchSize);
+    batch->msgs.resize(m_batchSize);
+    for(uint32_t i = 0; i < m_batchSize; i++)
+    {
+        batch->iovecs[i].iov_base = &batch->frames[i];
+        batch->iovecs[i].iov_len = sizeof(struct can_frame);
+        std::memset(&batch->msgs[i], 0, sizeof(struct mmsghdr));
+        batch->msgs[i].msg_hdr.msg_iov = &batch->iovecs[i];
+        batch->msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+    return batch;
+}
+
+
+std::shared_ptr<CanFrameBatch>
+SocketCanPort::ReadBatch()
+{
+    std::unique_ptr<CanFrameBatch> batch = AcquireBatch();
+
+    // 첫 프레임까지는 블로킹(타임아웃 있음), 그 뒤로는 이미 도착한 프레임만 가져옴
+    int received = recvmmsg(m_fd, batch->msgs.data(), batch->msgs.size(), MSG_WAITFORONE, nullptr);
+
+    batch->count = 0;
+    batch->wallNs = NowNs();
+    for(int i = 0; i < received; i++)
+    {
+        if(batch->msgs[i].msg_len != sizeof(struct can_frame))
+            continue;
+
+        // 길이가 맞지 않는 프레임(CAN FD 등)이 앞에 있었을 때만 당겨 옴
+        if(static_cast<uint32_t>(i) != batch->count)
+            batch->frames[batch->count] = batch->frames[i];
+        batch->count++;
+    }
+
+    std::shared_ptr<BatchPool> pool = m_pool;
+    auto release = [pool](CanFrameBatch* released) {
+        std::lock_guard<std::mutex> lock(pool->mutex);
+        pool->free.emplace_back(released);
+    };
+
+    if(batch->count == 0)
+    {
+        release(batch.release());
+        return nullptr;
+    }
+    return std::shared_ptr<CanFrameBatch>(batch.release(), release);
+}
+
+
+bool
+SocketCanPort::Write(const struct can_frame& frame)
+{
+    return write(m_fd, &frame, sizeof(frame)) == sizeof(frame);
+}
+
+
+int64_t
+SocketCanPort::NowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
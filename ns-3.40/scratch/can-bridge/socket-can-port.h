@@ -0,0 +1,80 @@
+#ifndef SOCKET_CAN_PORT_H
+#define SOCKET_CAN_PORT_H
+
+#include <linux/can.h>
+#include <sys/socket.h>
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/*
+ * Linux SocketCAN(RAW) 포트
+ *
+ * recvmmsg()로 여러 프레임을 시스템 콜 한 번에 읽습니다. 수신 버퍼(can_frame 배열)와
+ * mmsghdr / iovec 배열은 CanFrameBatch 하나로 묶어 풀에 보관하고, 커널이 프레임을 그 자리에 바로 써 넣습니다.
+ * ReadBatch()는 그 버퍼를 shared_ptr로 그대로 넘기며, 마지막 참조가 사라지면 버퍼가 풀로 돌아옵니다.
+ * 시뮬레이터가 이전 묶음을 처리하는 동안 읽기 스레드는 다른 버퍼에 읽으므로(다중 버퍼링)
+ * 프레임을 꺼내 복사할 필요가 없습니다.
+ */
+
+
+/// @brief recvmmsg() 한 번으로 받은 프레임 묶음
+struct CanFrameBatch
+{
+    std::vector<struct can_frame> frames;   ///< 커널이 바로 써 넣은 프레임, 앞의 count개가 유효
+    std::vector<uint32_t> tags;             ///< 사용자 값(can-bridge는 프레임별 디바이스 인덱스)
+    uint32_t count = 0;
+    int64_t wallNs = 0;                     ///< steady_clock 기준 수신 시각 (ns)
+
+    // recvmmsg() 인자, frames를 가리키도록 생성 시 한 번만 연결
+    std::vector<struct iovec> iovecs;
+    std::vector<struct mmsghdr> msgs;
+};
+
+
+/// @brief SocketCAN RAW 소켓 하나
+class SocketCanPort
+{
+  public:
+    /// @brief 인터페이스(vcan0 등)에 RAW 소켓을 열고 바인딩합니다. 실패하면 프로그램을 종료합니다.
+    /// @param iface 인터페이스 이름
+    /// @param batchSize recvmmsg() 한 번에 읽을 최대 프레임 수
+    /// @param timeoutMs 수신 타임아웃, 읽기 스레드가 종료 플래그를 확인하는 주기
+    SocketCanPort(const std::string& iface, uint32_t batchSize = 64, uint32_t timeoutMs = 100);
+    ~SocketCanPort();
+
+    SocketCanPort(const SocketCanPort&) = delete;
+    SocketCanPort& operator=(const SocketCanPort&) = delete;
+
+    /// @brief 도착한 프레임을 최대 batchSize개까지 풀의 버퍼에 바로 읽습니다.
+    /// @return 읽은 묶음, 타임아웃이거나 유효한 프레임이 없으면 nullptr
+    std::shared_ptr<CanFrameBatch> ReadBatch();
+
+    /// @brief 프레임 하나를 씁니다.
+    /// @param frame can_frame
+    /// @return 성공 여부
+    bool Write(const struct can_frame& frame);
+
+    /// @brief 현재 steady_clock 시각 (ns)
+    static int64_t NowNs();
+
+  private:
+    /// @brief 사용하지 않는 묶음 버퍼, 읽기 스레드와 시뮬레이터 스레드가 함께 접근
+    struct BatchPool
+    {
+        std::mutex mutex;
+        std::vector<std::unique_ptr<CanFrameBatch>> free;
+    };
+
+    /// @brief 풀에서 버퍼를 꺼내고, 없으면 새로 만듭니다.
+    std::unique_ptr<CanFrameBatch> AcquireBatch();
+
+    int m_fd;
+    uint32_t m_batchSize;
+    std::shared_ptr<BatchPool> m_pool;  ///< 넘겨준 묶음의 deleter도 참조하므로 포트보다 오래 살 수 있음
+};
+
+#endif /* SOCKET_CAN_PORT_H */
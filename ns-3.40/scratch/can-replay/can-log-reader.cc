@@ -0,0 +1,303 @@
+#include "can-log-reader.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+namespace
+{
+
+const char BINARY_MAGIC[8] = {'C', 'A', 'N', 'B', 'I', 'N', '0', '1'};
+const size_t BINARY_RECORD_SIZE = 24;
+
+/// SocketCAN 플래그 (linux/can.h와 같은 값)
+const uint32_t EFF_FLAG = 0x80000000U;
+const uint32_t RTR_FLAG = 0x40000000U;
+
+const uint8_t CAN_MAX_LEN = 8;
+const uint8_t CANFD_MAX_LEN = 64;
+
+
+/// @brief 16진수 문자 하나를 값으로 변환, 16진수가 아니면 -1
+int
+HexValue(char c)
+{
+    if(c >= '0' && c <= '9')
+        return c - '0';
+    if(c >= 'a' && c <= 'f')
+        return c - 'a' + 10;
+    if(c >= 'A' && c <= 'F')
+        return c - 'A' + 10;
+    return -1;
+}
+
+
+bool
+IsSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+
+/// @brief little-endian 정수를 읽습니다.
+uint64_t
+ReadLe(const unsigned char* p, uint32_t bytes)
+{
+    uint64_t value = 0;
+    for(uint32_t i = 0; i < bytes; i++)
+        value |= uint64_t(p[i]) << (8 * i);
+    return value;
+}
+
+
+/// @brief candump 로그 한 줄을 해석합니다. 문자열 할당 없이 맵핑된 메모리를 그대로 읽습니다.
+/// @param p 줄의 시작
+/// @param end 줄의 끝 (개행 문자 위치)
+/// @param frame 해석 결과
+/// @return 형식이 맞으면 true
+bool
+ParseCandumpLine(const char* p, const char* end, CanLogFrame& frame)
+{
+    while(p < end && IsSpace(*p))
+        p++;
+    if(p >= end || *p != '(')
+        return false;
+    p++;
+
+    // (초.마이크로초)
+    uint64_t seconds = 0;
+    while(p < end && *p >= '0' && *p <= '9')
+        seconds = seconds * 10 + (*p++ - '0');
+    if(p >= end || *p != '.')
+        return false;
+    p++;
+    uint64_t micros = 0;
+    uint32_t digits = 0;
+    while(p < end && *p >= '0' && *p <= '9')
+    {
+        if(digits < 6)
+            micros = micros * 10 + (*p - '0');
+        digits++;
+        p++;
+    }
+    for(; digits < 6; digits++)
+        micros *= 10;
+    if(p >= end || *p != ')')
+        return false;
+    p++;
+    frame.timestampUs = seconds * 1000000 + micros;
+
+    // 인터페이스 이름
+    while(p < end && IsSpace(*p))
+        p++;
+    while(p < end && !IsSpace(*p))
+        p++;
+    while(p < end && IsSpace(*p))
+        p++;
+
+    // ID#DATA, ID#R, ID##F DATA
+    uint32_t id = 0;
+    uint32_t idDigits = 0;
+    for(int v; p < end && (v = HexValue(*p)) >= 0; p++, idDigits++)
+        id = (id << 4) | v;
+    if(idDigits == 0 || p >= end || *p != '#')
+        return false;
+    p++;
+    frame.canId = idDigits > 3 ? (id | EFF_FLAG) : id;
+
+    uint8_t maxLen = CAN_MAX_LEN;
+    if(p < end && *p == '#')
+    {
+        // CAN FD: 플래그 니블 하나를 건너뜀
+        p += 2;
+        maxLen = CANFD_MAX_LEN;
+    }
+    else if(p < end && *p == 'R')
+    {
+        frame.canId |= RTR_FLAG;
+        frame.len = 0;
+        return true;
+    }
+
+    frame.len = 0;
+    while(p + 1 < end && frame.len < maxLen)
+    {
+        if(*p == '.')
+        {
+            p++;
+            continue;
+        }
+        int hi = HexValue(p[0]);
+        int lo = HexValue(p[1]);
+        if(hi < 0 || lo < 0)
+            break;
+        frame.data[frame.len++] = (hi << 4) | lo;
+        p += 2;
+    }
+    return true;
+}
+
+} // namespace
+
+
+CanLogReader::CanLogReader(const std::string& path, uint32_t reorderWindow)
+    : m_begin(nullptr),
+      m_cursor(nullptr),
+      m_end(nullptr),
+      m_length(0),
+      m_binary(false),
+      m_reorderWindow(reorderWindow ? reorderWindow : 1),
+      m_lastTimestampUs(0),
+      m_skippedLines(0),
+      m_lateFrames(0)
+{
+    m_fd = open(path.c_str(), O_RDONLY);
+    if(m_fd < 0)
+    {
+        std::cerr << "cannot open " << path << ": " << std::strerror(errno) << std::endl;
+        std::exit(1);
+    }
+
+    struct stat st;
+    if(fstat(m_fd, &st) < 0)
+    {
+        std::cerr << "cannot stat " << path << ": " << std::strerror(errno) << std::endl;
+        std::exit(1);
+    }
+    m_length = st.st_size;
+    if(m_length == 0)
+        return;
+
+    void* map = mmap(nullptr, m_length, PROT_READ, MAP_PRIVATE, m_fd, 0);
+    if(map == MAP_FAILED)
+    {
+        std::cerr << "cannot mmap " << path << ": " << std::strerror(errno) << std::endl;
+        std::exit(1);
+    }
+    madvise(map, m_length, MADV_SEQUENTIAL);
+
+    m_begin = static_cast<const char*>(map);
+    m_cursor = m_begin;
+    m_end = m_begin + m_length;
+
+    if(m_length >= sizeof(BINARY_MAGIC) && std::memcmp(m_begin, BINARY_MAGIC, sizeof(BINARY_MAGIC)) == 0)
+    {
+        m_binary = true;
+        m_cursor += sizeof(BINARY_MAGIC);
+    }
+}
+
+
+CanLogReader::~CanLogReader()
+{
+    if(m_begin)
+        munmap(const_cast<char*>(m_begin), m_length);
+    close(m_fd);
+}
+
+
+bool
+CanLogReader::Next(CanLogFrame& frame)
+{
+    while(m_pending.size() < m_reorderWindow && Fill())
+        ;
+    if(m_pending.empty())
+        return false;
+
+    frame = m_pending.top();
+    m_pending.pop();
+    m_lastTimestampUs = frame.timestampUs;
+    return true;
+}
+
+
+bool
+CanLogReader::PeekTimestamp(uint64_t& timestampUs)
+{
+    while(m_pending.size() < m_reorderWindow && Fill())
+        ;
+    if(m_pending.empty())
+        return false;
+
+    timestampUs = m_pending.top().timestampUs;
+    return true;
+}
+
+
+uint64_t
+CanLogReader::GetSkippedLines() const
+{
+    return m_skippedLines;
+}
+
+
+uint64_t
+CanLogReader::GetLateFrames() const
+{
+    return m_lateFrames;
+}
+
+
+bool
+CanLogReader::Fill()
+{
+    CanLogFrame frame;
+    if(!(m_binary ? ParseBinary(frame) : ParseText(frame)))
+        return false;
+
+    // 이미 내보낸 프레임보다 이른 프레임은 재정렬 창을 벗어난 것, 시각을 맞춰 순서를 유지
+    if(frame.timestampUs < m_lastTimestampUs)
+    {
+        frame.timestampUs = m_lastTimestampUs;
+        m_lateFrames++;
+    }
+    m_pending.push(frame);
+    return true;
+}
+
+
+bool
+CanLogReader::ParseText(CanLogFrame& frame)
+{
+    while(m_cursor < m_end)
+    {
+        const char* line = m_cursor;
+        const char* eol = static_cast<const char*>(std::memchr(line, '\n', m_end - line));
+        if(!eol)
+            eol = m_end;
+        m_cursor = eol < m_end ? eol + 1 : m_end;
+
+        if(ParseCandumpLine(line, eol, frame))
+            return true;
+
+        // 빈 줄은 세지 않음
+        while(line < eol && (IsSpace(*line)))
+            line++;
+        if(line < eol)
+            m_skippedLines++;
+    }
+    return false;
+}
+
+
+bool
+CanLogReader::ParseBinary(CanLogFrame& frame)
+{
+    if(m_end - m_cursor < static_cast<ptrdiff_t>(BINARY_RECORD_SIZE))
+        return false;
+
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(m_cursor);
+    frame.timestampUs = ReadLe(p, 8);
+    frame.canId = ReadLe(p + 8, 4);
+    frame.len = p[12] > CAN_MAX_LEN ? CAN_MAX_LEN : p[12];
+    std::memcpy(frame.data, p + 16, frame.len);
+
+    m_cursor += BINARY_RECORD_SIZE;
+    return true;
+}
@@ -0,0 +1,91 @@
+#ifndef CAN_LOG_READER_H
+#define CAN_LOG_READER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <queue>
+#include <string>
+#include <vector>
+
+/*
+ * 메모리 맵으로 여는 CAN 버스 로그 리더
+ *
+ * 지원 형식
+ *  - candump 로그(candump -l): "(1436509052.249713) vcan0 044#2A366C2BBA"
+ *    CAN FD("ID##F DATA")와 RTR("ID#R")도 읽습니다.
+ *  - 바이너리: 8 byte 매직 "CANBIN01" 뒤에 24 byte 레코드가 반복
+ *    (uint64 타임스탬프 us, uint32 CAN ID, uint8 길이, 3 byte 패딩, 8 byte 데이터, 모두 little-endian)
+ *
+ * 파일 전체를 mmap()하고 Next()가 불릴 때마다 한 프레임씩만 해석합니다.
+ * 로그 전체를 메모리에 올리지 않으며, 해석이 끝난 페이지는 커널이 언제든 회수할 수 있습니다.
+ * 타임스탬프가 약간 뒤섞인 로그를 위해 reorderWindow개 프레임까지 최소 힙으로 정렬해 내보냅니다.
+ */
+
+
+/// @brief 로그에서 읽은 CAN(FD) 프레임 하나
+struct CanLogFrame
+{
+    uint64_t timestampUs;
+    uint32_t canId;         ///< EFF/RTR 플래그를 포함한 SocketCAN 형식 ID
+    uint8_t len;
+    uint8_t data[64];
+};
+
+
+/// @brief mmap 기반 CAN 로그 스트림
+class CanLogReader
+{
+  public:
+    /// @brief 로그 파일을 엽니다. 열 수 없거나 형식이 잘못되면 프로그램을 종료합니다.
+    /// @param path 로그 파일 경로
+    /// @param reorderWindow 타임스탬프 재정렬에 사용하는 최대 프레임 수
+    explicit CanLogReader(const std::string& path, uint32_t reorderWindow = 64);
+    ~CanLogReader();
+
+    CanLogReader(const CanLogReader&) = delete;
+    CanLogReader& operator=(const CanLogReader&) = delete;
+
+    /// @brief 타임스탬프 순서로 다음 프레임을 꺼냅니다.
+    /// @param frame 꺼낸 프레임
+    /// @return 로그가 끝났으면 false
+    bool Next(CanLogFrame& frame);
+
+    /// @brief 다음 프레임의 타임스탬프를 꺼내지 않고 확인합니다.
+    /// @param timestampUs 다음 프레임의 타임스탬프
+    /// @return 로그가 끝났으면 false
+    bool PeekTimestamp(uint64_t& timestampUs);
+
+    /// @brief 해석하지 못하고 건너뛴 줄 수
+    uint64_t GetSkippedLines() const;
+
+    /// @brief 순서가 뒤바뀌어 재정렬 창으로도 바로잡지 못한 프레임 수 (직전 프레임 시각으로 맞춤)
+    uint64_t GetLateFrames() const;
+
+  private:
+    /// @brief 파일에서 프레임 하나를 해석해 재정렬 힙에 넣습니다.
+    bool Fill();
+    bool ParseText(CanLogFrame& frame);
+    bool ParseBinary(CanLogFrame& frame);
+
+    struct Later
+    {
+        bool operator()(const CanLogFrame& a, const CanLogFrame& b) const
+        {
+            return a.timestampUs > b.timestampUs;
+        }
+    };
+
+    int m_fd;
+    const char* m_begin;
+    const char* m_cursor;
+    const char* m_end;
+    size_t m_length;
+    bool m_binary;
+    uint32_t m_reorderWindow;
+    std::priority_queue<CanLogFrame, std::vector<CanLogFrame>, Later> m_pending;
+    uint64_t m_lastTimestampUs;
+    uint64_t m_skippedLines;
+    uint64_t m_lateFrames;
+};
+
+#endif /* CAN_LOG_READER_H */
@@ -0,0 +1,270 @@
+/*
+ * 녹화된 CAN 버스 로그(candump / 바이너리)를 LR-WPAN 트래픽으로 재생
+ *
+ * CanLogReader가 mmap()한 로그에서 프레임을 하나씩 꺼내고, 이벤트 큐에는 항상 "다음 프레임"
+ * 이벤트 하나만 둡니다. 이벤트가 실행되면 그 프레임을 CAN ID에 매핑된 디바이스의
+ * MCPS-DATA.request로 보내고, 같은 시각의 프레임을 모두 처리한 뒤 다음 프레임 시각에 자신을 다시
+ * 예약합니다. 따라서 로그 크기와 관계없이 메모리 사용량과 이벤트 큐 길이가 일정합니다.
+ *
+ * 모든 디바이스는 게이트웨이(코디네이터, 00:01)에게 전송하며, 종료 시 재생 / 전달 통계와
+ * wall-clock 재생 속도를 출력합니다.
+ *
+ * 사용 예:
+ *   ./ns3 run "can-replay --log=/data/drive.log --devices=16 --map=0x100:1,0x200:2"
+ *   ./ns3 run "can-replay --log=/data/drive.bin --speed=10 --maxFrames=1000000"
+ */
+#include "can-log-reader.h"
+
+#include <ns3/core-module.h>
+#include <ns3/lr-wpan-module.h>
+#include <ns3/mobility-module.h>
+#include <ns3/network-module.h>
+#include <ns3/simulator.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <unordered_map>
+#include <vector>
+
+using namespace ns3;
+
+const int COORDINATOR_PAN_ID = 5;
+
+/// SocketCAN ID 마스크 / 플래그 (linux/can.h와 같은 값)
+const uint32_t CAN_ID_MASK = 0x1FFFFFFFU;
+
+
+/// @brief 재생 상태
+struct ReplayState
+{
+    std::unique_ptr<CanLogReader> reader;
+    std::vector<Ptr<LrWpanMac>> macs;                   ///< 디바이스 인덱스 -> MAC (0번은 게이트웨이)
+    std::unordered_map<uint32_t, uint32_t> canIdMap;    ///< CAN ID -> 디바이스 인덱스
+    bool mapUnknown = true;
+    bool ack = true;
+    uint64_t firstTimestampUs = 0;
+    double speed = 1.0;                                 ///< 로그 시간 대비 시뮬레이션 시간 배속
+    Time offset;
+    uint64_t maxFrames = 0;
+
+    uint64_t replayed = 0;
+    uint64_t unmapped = 0;
+    uint64_t delivered = 0;
+    uint64_t confirmed = 0;
+    uint64_t failed = 0;
+};
+
+static ReplayState g_replay;
+
+
+/// @brief 로그 타임스탬프를 시뮬레이션 시각으로 변환합니다.
+static Time
+ToSimTime(uint64_t timestampUs)
+{
+    return g_replay.offset + MicroSeconds(static_cast<uint64_t>((timestampUs - g_replay.firstTimestampUs) / g_replay.speed));
+}
+
+
+/// @brief 프레임 하나를 매핑된 디바이스의 MCPS-DATA.request로 보냅니다.
+/// @param frame CAN 프레임
+static void
+SendFrame(const CanLogFrame& frame)
+{
+    static uint8_t msduHandle = 0;
+
+    uint32_t canId = frame.canId & CAN_ID_MASK;
+    uint32_t index;
+    auto it = g_replay.canIdMap.find(canId);
+    if(it != g_replay.canIdMap.end())
+        index = it->second;
+    else if(g_replay.mapUnknown)
+        index = canId % (g_replay.macs.size() - 1) + 1;
+    else
+    {
+        g_replay.unmapped++;
+        return;
+    }
+
+    // 페이로드: CAN ID(4 byte, 플래그 포함) + 데이터
+    uint8_t buffer[4 + sizeof(frame.data)];
+    buffer[0] = frame.canId >> 24;
+    buffer[1] = frame.canId >> 16;
+    buffer[2] = frame.canId >> 8;
+    buffer[3] = frame.canId;
+    std::copy(frame.data, frame.data + frame.len, buffer + 4);
+
+    McpsDataRequestParams params;
+    params.m_dstPanId = COORDINATOR_PAN_ID;
+    params.m_srcAddrMode = SHORT_ADDR;
+    params.m_dstAddrMode = SHORT_ADDR;
+    params.m_dstAddr = Mac16Address("00:01");
+    params.m_msduHandle = msduHandle++;
+    params.m_txOptions = g_replay.ack ? TX_OPTION_ACK : TX_OPTION_NONE;
+
+    g_replay.macs[index]->McpsDataRequest(params, Create<Packet>(buffer, 4 + frame.len));
+    g_replay.replayed++;
+}
+
+
+/// @brief 현재 시각의 프레임을 모두 보내고 다음 프레임 시각에 자신을 다시 예약합니다.
+/// 이벤트 큐에는 재생 이벤트가 항상 하나만 존재합니다.
+static void
+ReplayNext()
+{
+    CanLogFrame frame;
+    uint64_t nextUs;
+
+    while(g_replay.reader->PeekTimestamp(nextUs) && ToSimTime(nextUs) <= Simulator::Now())
+    {
+        if(g_replay.maxFrames && g_replay.replayed >= g_replay.maxFrames)
+            return;
+        g_replay.reader->Next(frame);
+        SendFrame(frame);
+    }
+
+    if(!g_replay.reader->PeekTimestamp(nextUs))
+        return;
+    if(g_replay.maxFrames && g_replay.replayed >= g_replay.maxFrames)
+        return;
+
+    Simulator::Schedule(ToSimTime(nextUs) - Simulator::Now(), &ReplayNext);
+}
+
+
+/// @brief 게이트웨이의 MCPS-DATA.indication 콜백
+static void
+GatewayDataIndication(McpsDataIndicationParams params, Ptr<Packet> p)
+{
+    g_replay.delivered++;
+}
+
+
+/// @brief 디바이스의 MCPS-DATA.confirm 콜백
+static void
+McpsDataConfirm(McpsDataConfirmParams params)
+{
+    if(params.m_status == IEEE_802_15_4_SUCCESS)
+        g_replay.confirmed++;
+    else
+        g_replay.failed++;
+}
+
+
+/// @brief "0x100:1,0x200:2" 형식의 매핑을 읽습니다.
+/// @return 가장 큰 디바이스 인덱스
+static uint32_t
+ParseCanIdMap(const std::string& map)
+{
+    uint32_t maxIndex = 0;
+    std::stringstream ss(map);
+    std::string entry;
+    while(std::getline(ss, entry, ','))
+    {
+        size_t colon = entry.find(':');
+        NS_ABORT_MSG_IF(colon == std::string::npos, "invalid CAN ID mapping: " << entry);
+        uint32_t canId = std::stoul(entry.substr(0, colon), nullptr, 0);
+        uint32_t index = std::stoul(entry.substr(colon + 1));
+        NS_ABORT_MSG_IF(index == 0, "device index 0 is the gateway");
+        g_replay.canIdMap[canId] = index;
+        maxIndex = std::max(maxIndex, index);
+    }
+    return maxIndex;
+}
+
+
+int main(int argc, char* argv[])
+{
+    std::string logPath;
+    std::string map;
+    uint32_t deviceCount = 8;
+    uint32_t reorderWindow = 64;
+    double maxSimTime = 0;
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("log", "candump 로그 또는 CANBIN01 바이너리 로그 경로", logPath);
+    cmd.AddValue("map", "CAN ID -> 디바이스 인덱스 매핑, 예: 0x100:1,0x200:2", map);
+    cmd.AddValue("mapUnknown", "매핑에 없는 CAN ID를 ID % devices 디바이스로 보낼지 여부", g_replay.mapUnknown);
+    cmd.AddValue("devices", "게이트웨이를 제외한 디바이스 수", deviceCount);
+    cmd.AddValue("speed", "로그 시간 대비 재생 배속", g_replay.speed);
+    cmd.AddValue("ack", "TX_OPTION_ACK 사용 여부", g_replay.ack);
+    cmd.AddValue("maxFrames", "재생할 최대 프레임 수, 0이면 전체", g_replay.maxFrames);
+    cmd.AddValue("reorder", "타임스탬프 재정렬 창 크기 (프레임)", reorderWindow);
+    cmd.AddValue("simTime", "최대 시뮬레이션 시간 (s), 0이면 로그 끝까지", maxSimTime);
+    cmd.Parse(argc, argv);
+
+    NS_ABORT_MSG_IF(logPath.empty(), "--log is required");
+    NS_ABORT_MSG_IF(g_replay.speed <= 0, "--speed must be positive");
+    deviceCount = std::max(deviceCount, ParseCanIdMap(map));
+    NS_ABORT_MSG_IF(deviceCount == 0 && g_replay.mapUnknown, "--mapUnknown needs at least one device (--devices or --map)");
+
+    g_replay.reader = std::make_unique<CanLogReader>(logPath, reorderWindow);
+
+    NodeContainer pan;
+    pan.Create(deviceCount + 1);
+
+    MobilityHelper mobilityHelper;
+    mobilityHelper.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+    mobilityHelper.SetPositionAllocator("ns3::GridPositionAllocator",
+                                        "MinX", DoubleValue(0.0),
+                                        "MinY", DoubleValue(0.0),
+                                        "DeltaX", DoubleValue(5.0),
+                                        "DeltaY", DoubleValue(5.0),
+                                        "GridWidth", UintegerValue(5),
+                                        "LayoutType", StringValue("RowFirst"));
+    mobilityHelper.Install(pan);
+
+    LrWpanHelper lrWpanHelper;
+    NetDeviceContainer netDevices = lrWpanHelper.Install(pan);
+    lrWpanHelper.CreateAssociatedPan(netDevices, COORDINATOR_PAN_ID);
+
+    // 프레임마다 DynamicCast하지 않도록 MAC을 미리 모아 둠
+    for(uint32_t i = 0; i < netDevices.GetN(); i++)
+    {
+        Ptr<LrWpanMac> mac = DynamicCast<LrWpanNetDevice>(netDevices.Get(i))->GetMac();
+        g_replay.macs.push_back(mac);
+        if(i == 0)
+            mac->SetMcpsDataIndicationCallback(MakeCallback(&GatewayDataIndication));
+        else
+            mac->SetMcpsDataConfirmCallback(MakeCallback(&McpsDataConfirm));
+    }
+
+    uint64_t firstUs;
+    if(!g_replay.reader->PeekTimestamp(firstUs))
+    {
+        std::cout << "log " << logPath << " contains no frames" << std::endl;
+        return 0;
+    }
+    g_replay.firstTimestampUs = firstUs;
+    g_replay.offset = Seconds(1);
+    Simulator::Schedule(g_replay.offset, &ReplayNext);
+
+    if(maxSimTime > 0)
+        Simulator::Stop(Seconds(maxSimTime));
+
+    auto wallStart = std::chrono::steady_clock::now();
+    Simulator::Run();
+    double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+
+    std::cout
+        << "replayed " << g_replay.replayed << " frames"
+        << " (unmapped " << g_replay.unmapped
+        << ", unparsable lines " << g_replay.reader->GetSkippedLines()
+        << ", reordered beyond window " << g_replay.reader->GetLateFrames() << ")"
+        << std::endl
+        << "delivered " << g_replay.delivered
+        << ", confirmed " << g_replay.confirmed
+        << ", failed " << g_replay.failed
+        << std::endl
+        << "simulated " << Simulator::Now().As(Time::S)
+        << " in " << wallSeconds << " s wall-clock"
+        << " (" << (wallSeconds > 0 ? g_replay.replayed / wallSeconds : 0) << " frames/s)"
+        << std::endl
+    ;
+
+    Simulator::Destroy();
+
+    return 0;
+}
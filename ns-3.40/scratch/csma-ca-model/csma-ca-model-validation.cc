@@ -0,0 +1,315 @@
+/*
+ * CSMA-CA 해석 모델 검증
+ *
+ * 코디네이터 하나와 포화 상태의 디바이스 N개로 이루어진 PAN을 시뮬레이션하고,
+ * 같은 설정으로 SolveCsmaCaModel()을 풀어 처리량 / 충돌 확률 / 채널 접근 실패 확률 /
+ * 평균 서비스 시간(MCPS-DATA.request -> MCPS-DATA.confirm)을 나란히 출력합니다.
+ *
+ * 충돌 확률을 직접 측정할 수 있도록 macMaxFrameRetries = 0으로 두고
+ * NO_ACK로 끝난 전송을 충돌로 셉니다.
+ *
+ * 사용 예:
+ *   ./ns3 run "csma-ca-model-validation --nodes=2,5,10,20 --minBE=3 --maxBackoffs=4"
+ */
+#include "lr-wpan-csma-ca-model.h"
+
+#include <ns3/core-module.h>
+#include <ns3/lr-wpan-module.h>
+#include <ns3/mobility-module.h>
+#include <ns3/network-module.h>
+#include <ns3/simulator.h>
+
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+using namespace ns3;
+
+const int COORDINATOR_PAN_ID = 5;
+const int COORDINATOR_CHANNEL = 11;
+
+
+/// @brief 시뮬레이션 한 번의 측정값
+struct SimulationStats
+{
+    uint32_t success = 0;
+    uint32_t noAck = 0;
+    uint32_t accessFailure = 0;
+    double serviceTimeSum = 0;
+    uint32_t confirms = 0;
+    bool measuring = false;
+};
+
+static SimulationStats g_stats;
+
+/// 디바이스별 마지막 MCPS-DATA.request 시각
+static std::vector<Time> g_requestTime;
+
+
+/// @brief 디바이스가 코디네이터에게 패킷 하나를 보냅니다.
+/// @param index 디바이스 인덱스
+/// @param mac Ptr<LrWpanMac>
+/// @param payloadSize MSDU 크기
+static void
+SendData(uint32_t index, Ptr<LrWpanMac> mac, uint32_t payloadSize)
+{
+    static uint8_t msduHandle = 0;
+
+    McpsDataRequestParams params;
+    params.m_dstPanId = COORDINATOR_PAN_ID;
+    params.m_srcAddrMode = SHORT_ADDR;
+    params.m_dstAddrMode = SHORT_ADDR;
+    params.m_dstAddr = Mac16Address("00:01");
+    params.m_msduHandle = msduHandle++;
+    params.m_txOptions = TX_OPTION_ACK;
+
+    g_requestTime[index] = Simulator::Now();
+    mac->McpsDataRequest(params, Create<Packet>(payloadSize));
+}
+
+
+/// @brief MCPS-DATA.confirm 콜백, 결과를 집계하고 곧바로 다음 패킷을 보내 포화 상태를 유지합니다.
+/// @param index 디바이스 인덱스
+/// @param mac Ptr<LrWpanMac>
+/// @param payloadSize MSDU 크기
+/// @param params McpsDataConfirmParams
+static void
+McpsDataConfirm(uint32_t index, Ptr<LrWpanMac> mac, uint32_t payloadSize, McpsDataConfirmParams params)
+{
+    if(g_stats.measuring)
+    {
+        switch(params.m_status)
+        {
+            case IEEE_802_15_4_SUCCESS:
+                g_stats.success++;
+                break;
+            case IEEE_802_15_4_NO_ACK:
+                g_stats.noAck++;
+                break;
+            case IEEE_802_15_4_CHANNEL_ACCESS_FAILURE:
+                g_stats.accessFailure++;
+                break;
+            default:
+                break;
+        }
+        g_stats.serviceTimeSum += (Simulator::Now() - g_requestTime[index]).GetSeconds();
+        g_stats.confirms++;
+    }
+
+    Simulator::ScheduleNow(&SendData, index, mac, payloadSize);
+}
+
+
+/// @brief 모델과 같은 설정으로 포화 상태 PAN을 시뮬레이션합니다.
+/// @param params 모델 입력과 같은 설정
+/// @param bcnOrd slotted일 때 사용하는 비콘 차수 (BO = SO, CAP이 슈퍼프레임 전체를 차지)
+/// @param measureTime 측정 시간
+/// @return 측정값
+static SimulationStats
+RunSimulation(const CsmaCaModelParams& params, uint8_t bcnOrd, Time measureTime)
+{
+    g_stats = SimulationStats();
+    g_requestTime.assign(params.nodeCount + 1, Seconds(0));
+
+    NodeContainer pan;
+    pan.Create(params.nodeCount + 1);
+
+    // 숨은 노드가 없도록 모든 노드를 좁은 원 위에 배치
+    MobilityHelper mobilityHelper;
+    mobilityHelper.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+    mobilityHelper.SetPositionAllocator("ns3::UniformDiscPositionAllocator",
+                                        "rho", DoubleValue(5.0));
+    mobilityHelper.Install(pan);
+
+    LrWpanHelper lrWpanHelper;
+    NetDeviceContainer netDevices = lrWpanHelper.Install(pan);
+    lrWpanHelper.CreateAssociatedPan(netDevices, COORDINATOR_PAN_ID);
+
+    Time start = Seconds(1);
+    if(params.slotted)
+    {
+        MlmeStartRequestParams startParams;
+        startParams.m_panCoor = true;
+        startParams.m_PanId = COORDINATOR_PAN_ID;
+        startParams.m_bcnOrd = bcnOrd;
+        startParams.m_sfrmOrd = bcnOrd;
+        startParams.m_logCh = COORDINATOR_CHANNEL;
+        Simulator::ScheduleWithContext(pan.Get(0)->GetId(),
+                                       Seconds(0.5),
+                                       &LrWpanMac::MlmeStartRequest,
+                                       DynamicCast<LrWpanNetDevice>(netDevices.Get(0))->GetMac(),
+                                       startParams);
+        start += Seconds(aBaseSuperframeDuration * std::pow(2.0, bcnOrd) * 16e-6 * 2);
+    }
+
+    for(uint32_t i = 1; i < netDevices.GetN(); i++)
+    {
+        Ptr<LrWpanNetDevice> netDevice = DynamicCast<LrWpanNetDevice>(netDevices.Get(i));
+        Ptr<LrWpanMac> mac = netDevice->GetMac();
+        Ptr<LrWpanCsmaCa> csmaCa = netDevice->GetCsmaCa();
+
+        csmaCa->SetMacMaxBE(params.macMaxBE);
+        csmaCa->SetMacMinBE(params.macMinBE);
+        csmaCa->SetMacMaxCSMABackoffs(params.macMaxCSMABackoffs);
+        mac->SetMacMaxFrameRetries(params.macMaxFrameRetries);
+
+        mac->SetMcpsDataConfirmCallback(MakeBoundCallback(&McpsDataConfirm, i, mac, params.payloadSize));
+
+        if(params.slotted)
+        {
+            MlmeSyncRequestParams syncParams;
+            syncParams.m_logCh = COORDINATOR_CHANNEL;
+            syncParams.m_trackBcn = true;
+            Simulator::ScheduleWithContext(pan.Get(i)->GetId(),
+                                           Seconds(0.5),
+                                           &LrWpanMac::MlmeSyncRequest,
+                                           mac,
+                                           syncParams);
+        }
+
+        Simulator::ScheduleWithContext(pan.Get(i)->GetId(),
+                                       start + MicroSeconds(i * 37),
+                                       &SendData,
+                                       i,
+                                       mac,
+                                       params.payloadSize);
+    }
+
+    // 처음 1초는 워밍업
+    Simulator::Schedule(start + Seconds(1), []() { g_stats.measuring = true; });
+    Simulator::Stop(start + Seconds(1) + measureTime);
+    Simulator::Run();
+    Simulator::Destroy();
+
+    return g_stats;
+}
+
+
+/// @brief "2,5,10" 형식의 문자열을 숫자 목록으로 변환합니다.
+static std::vector<uint32_t>
+ParseList(const std::string& list)
+{
+    std::vector<uint32_t> values;
+    std::stringstream ss(list);
+    std::string item;
+    while(std::getline(ss, item, ','))
+    {
+        if(!item.empty())
+            values.push_back(std::stoul(item));
+    }
+    return values;
+}
+
+
+/// @brief 모델 값과 측정값의 상대 오차(%)
+static double
+RelativeError(double model, double measured)
+{
+    if(measured == 0)
+        return model == 0 ? 0 : 100;
+    return 100 * std::fabs(model - measured) / measured;
+}
+
+
+int main(int argc, char* argv[])
+{
+    std::string nodes = "2,5,10,20";
+    std::string modes = "unslotted,slotted";
+    uint32_t minBE = 3;
+    uint32_t maxBE = 5;
+    uint32_t maxBackoffs = 4;
+    uint32_t payloadSize = 20;
+    uint32_t bcnOrd = 6;
+    double measureSeconds = 30;
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("nodes", "쉼표로 구분한 디바이스 수 목록", nodes);
+    cmd.AddValue("modes", "unslotted, slotted 중 검증할 모드", modes);
+    cmd.AddValue("minBE", "macMinBE", minBE);
+    cmd.AddValue("maxBE", "macMaxBE", maxBE);
+    cmd.AddValue("maxBackoffs", "macMaxCSMABackoffs", maxBackoffs);
+    cmd.AddValue("payload", "MSDU 크기 (byte)", payloadSize);
+    cmd.AddValue("bcnOrd", "slotted 검증에 사용하는 BO = SO", bcnOrd);
+    cmd.AddValue("measureTime", "설정별 측정 시간 (s)", measureSeconds);
+    cmd.Parse(argc, argv);
+
+    std::cout
+        << std::left
+        << std::setw(10) << "mode"
+        << std::setw(6) << "N"
+        << std::setw(22) << "throughput(pkt/s)"
+        << std::setw(22) << "collision prob"
+        << std::setw(22) << "access failure"
+        << std::setw(22) << "service time(ms)"
+        << std::setw(14) << "model(us)"
+        << std::setw(12) << "sim(s)"
+        << std::endl
+    ;
+
+    std::vector<bool> slottedModes;
+    std::stringstream modeList(modes);
+    std::string mode;
+    while(std::getline(modeList, mode, ','))
+    {
+        NS_ABORT_MSG_IF(mode != "slotted" && mode != "unslotted", "unknown mode: " << mode);
+        slottedModes.push_back(mode == "slotted");
+    }
+
+    for(bool slotted : slottedModes)
+    {
+        for(uint32_t n : ParseList(nodes))
+        {
+            CsmaCaModelParams params;
+            params.nodeCount = n;
+            params.slotted = slotted;
+            params.macMinBE = minBE;
+            params.macMaxBE = maxBE;
+            params.macMaxCSMABackoffs = maxBackoffs;
+            params.macMaxFrameRetries = 0;
+            params.ack = true;
+            params.payloadSize = payloadSize;
+
+            auto modelStart = std::chrono::steady_clock::now();
+            CsmaCaModelResult model = SolveCsmaCaModel(params);
+            double modelMicros = std::chrono::duration<double, std::micro>(
+                std::chrono::steady_clock::now() - modelStart).count();
+
+            auto simStart = std::chrono::steady_clock::now();
+            SimulationStats sim = RunSimulation(params, bcnOrd, Seconds(measureSeconds));
+            double simSeconds = std::chrono::duration<double>(
+                std::chrono::steady_clock::now() - simStart).count();
+
+            uint32_t transmitted = sim.success + sim.noAck;
+            double simThroughput = sim.success / measureSeconds;
+            double simCollision = transmitted ? static_cast<double>(sim.noAck) / transmitted : 0;
+            double simFailure = sim.confirms ? static_cast<double>(sim.accessFailure) / sim.confirms : 0;
+            double simService = sim.confirms ? sim.serviceTimeSum / sim.confirms : 0;
+
+            auto cell = [](double model, double measured, double scale) {
+                std::ostringstream os;
+                os << std::fixed << std::setprecision(3)
+                   << model * scale << "/" << measured * scale
+                   << " (" << std::setprecision(0) << RelativeError(model, measured) << "%)";
+                return os.str();
+            };
+
+            std::cout
+                << std::left
+                << std::setw(10) << (slotted ? "slotted" : "unslotted")
+                << std::setw(6) << n
+                << std::setw(22) << cell(model.throughput, simThroughput, 1)
+                << std::setw(22) << cell(model.collisionProbability, simCollision, 1)
+                << std::setw(22) << cell(model.accessFailureProbability, simFailure, 1)
+                << std::setw(22) << cell(model.meanServiceTime, simService, 1e3)
+                << std::setw(14) << std::fixed << std::setprecision(1) << modelMicros
+                << std::setw(12) << std::setprecision(2) << simSeconds
+                << std::endl
+            ;
+        }
+    }
+
+    return 0;
+}
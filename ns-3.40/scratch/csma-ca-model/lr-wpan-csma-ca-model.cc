@@ -0,0 +1,241 @@
+#include "lr-wpan-csma-ca-model.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace
+{
+
+/// 2.4 GHz O-QPSK 심볼 길이 (s)
+const double SYMBOL_SECONDS = 16e-6;
+
+/// aUnitBackoffPeriod (심볼), 모델의 슬롯 길이
+const double BACKOFF_PERIOD_SYMBOLS = 20;
+
+/// aTurnaroundTime (심볼)
+const double TURNAROUND_SYMBOLS = 12;
+
+/// CCA 수행 시간 8 심볼 (phyCcaDuration)
+const double CCA_SYMBOLS = 8;
+
+/// macAckWaitDuration (심볼): aUnitBackoffPeriod + aTurnaroundTime + phySHRDuration + 6 * phySymbolsPerOctet
+const double ACK_WAIT_SYMBOLS = 54;
+
+/// SHR(4 + 1 byte) + PHR(1 byte)
+const uint32_t PHY_OVERHEAD_BYTES = 6;
+
+/// 짧은 주소 + PAN ID 압축 데이터 프레임의 MAC 헤더(9 byte) + FCS(2 byte)
+const uint32_t MAC_DATA_OVERHEAD_BYTES = 11;
+
+/// ACK 프레임 MPDU 길이
+const uint32_t MAC_ACK_BYTES = 5;
+
+/// aMaxSIFSFrameSize: 이보다 긴 MPDU 뒤에는 LIFS를 둠
+const uint32_t MAX_SIFS_FRAME_SIZE = 18;
+const double SIFS_SYMBOLS = 12;
+const double LIFS_SYMBOLS = 40;
+
+/// 이분법 종료 조건
+const double TOLERANCE = 1e-6;
+
+/// alpha, beta가 주어졌을 때 충돌 확률을 맞추는 내부 반복 횟수 (충돌 확률은 주기 길이에만 약하게 영향)
+const uint32_t COLLISION_ITERATIONS = 4;
+
+/// alpha 상한, 채널이 항상 사용 중이면 모델이 퇴화하므로 1 미만으로 제한
+const double MAX_BUSY = 0.999;
+
+
+/// @brief 충돌 후 재전송을 포함해 패킷 하나에 기대되는 전송 시도 횟수
+double
+ExpectedAttempts(double fail, uint32_t retries)
+{
+    if(fail >= 1)
+        return retries + 1;
+    return (1 - std::pow(fail, retries + 1)) / (1 - fail);
+}
+
+
+/// @brief 심볼 수를 슬롯 수로 변환, slotted CSMA-CA는 백오프 경계에 맞춰 올림
+double
+ToSlots(double symbols, bool slotted)
+{
+    double slots = symbols / BACKOFF_PERIOD_SYMBOLS;
+    return slotted ? std::ceil(slots) : slots;
+}
+
+
+/// @brief 입력으로부터 미리 계산해 둔 상수
+struct ModelConstants
+{
+    double n;
+    uint32_t retries;
+    double slotSeconds;
+    std::vector<double> meanBackoff;    ///< 백오프 단계별 평균 백오프 슬롯 수
+    double busySlots;                   ///< 전송 하나가 다른 노드의 CCA를 busy로 만드는 시간
+    double successSlots;                ///< 성공한 전송이 태그 노드를 점유하는 시간
+    double collisionSlots;              ///< 충돌한 전송이 태그 노드를 점유하는 시간
+};
+
+
+/// @brief 태그 노드의 백오프 체인을 주어진 alpha, beta에 대해 풀어낸 결과
+struct ChainState
+{
+    double x;               ///< CCA 한 번(slotted에서는 CCA1 + CCA2)이 busy로 끝날 확률
+    double pTx;             ///< 시도 한 번이 전송까지 가는 확률
+    double tau;
+    double q;               ///< 슬롯당 전송 시작 확률
+    double pc;
+    double expectedCycle;   ///< 시도 한 번의 평균 슬롯 수
+};
+
+
+/// @brief alpha, beta가 주어졌을 때 태그 노드의 tau와 충돌 확률을 계산합니다.
+ChainState
+EvaluateChain(const CsmaCaModelParams& params, const ModelConstants& c, double alpha, double beta)
+{
+    ChainState s {};
+    s.x = params.slotted ? alpha + (1 - alpha) * beta : alpha;
+
+    // 시도 한 번 동안 기대되는 CCA 횟수와 백오프 + CCA 슬롯 수
+    double ccaSlots = params.slotted ? 1 + (1 - alpha) : CCA_SYMBOLS / BACKOFF_PERIOD_SYMBOLS;
+    double expectedCca = 0;
+    double expectedBackoff = 0;
+    double xi = 1;
+    for(double backoff : c.meanBackoff)
+    {
+        expectedCca += xi;
+        expectedBackoff += xi * (backoff + ccaSlots);
+        xi *= s.x;
+    }
+    s.pTx = 1 - xi;         // xi == x^(m+1)
+
+    for(uint32_t i = 0; i < COLLISION_ITERATIONS; i++)
+    {
+        double txSlots = s.pc * c.collisionSlots + (1 - s.pc) * c.successSlots;
+        s.expectedCycle = expectedBackoff + s.pTx * txSlots;
+
+        // 비포화 상태: 노드가 보낼 패킷을 가지고 있는 시간 비율만큼 시도 확률을 낮춤
+        double busyFraction = 1;
+        if(params.packetRate > 0)
+        {
+            double attempts = ExpectedAttempts(s.pTx * s.pc, c.retries);
+            busyFraction = std::min(1.0, params.packetRate * attempts * s.expectedCycle * c.slotSeconds);
+        }
+
+        s.tau = busyFraction * expectedCca / s.expectedCycle;
+        s.q = s.tau * (1 - s.x);
+        s.pc = 1 - std::pow(1 - s.q, c.n - 1);
+    }
+
+    return s;
+}
+
+
+/// @brief f(v) - v가 단조 감소할 때 f(v) = v인 v를 [0, MAX_BUSY]에서 이분법으로 찾습니다.
+template <typename F>
+double
+Bisect(F f, uint32_t& evaluations)
+{
+    double lo = 0;
+    double hi = MAX_BUSY;
+    while(hi - lo > TOLERANCE)
+    {
+        double mid = (lo + hi) / 2;
+        evaluations++;
+        if(f(mid) > mid)
+            lo = mid;
+        else
+            hi = mid;
+    }
+    return (lo + hi) / 2;
+}
+
+} // namespace
+
+
+CsmaCaModelResult
+SolveCsmaCaModel(const CsmaCaModelParams& params)
+{
+    ModelConstants c;
+    c.n = std::max<uint32_t>(params.nodeCount, 1);
+    c.retries = params.ack ? params.macMaxFrameRetries : 0;
+    c.slotSeconds = BACKOFF_PERIOD_SYMBOLS * SYMBOL_SECONDS;
+
+    // W_i = 2^min(minBE + i, maxBE), 평균 백오프 (W_i - 1) / 2
+    for(uint32_t i = 0; i <= params.macMaxCSMABackoffs; i++)
+    {
+        uint32_t be = std::min<uint32_t>(params.macMinBE + i, params.macMaxBE);
+        c.meanBackoff.push_back((std::pow(2.0, be) - 1) / 2);
+    }
+
+    const uint32_t mpduBytes = params.payloadSize + MAC_DATA_OVERHEAD_BYTES;
+    const double frameSymbols = 2.0 * (mpduBytes + PHY_OVERHEAD_BYTES);
+    const double ackSymbols = 2.0 * (MAC_ACK_BYTES + PHY_OVERHEAD_BYTES);
+    const double ifsSymbols = mpduBytes > MAX_SIFS_FRAME_SIZE ? LIFS_SYMBOLS : SIFS_SYMBOLS;
+
+    c.busySlots = ToSlots(frameSymbols + (params.ack ? TURNAROUND_SYMBOLS + ackSymbols : 0), params.slotted);
+    c.successSlots = ToSlots(TURNAROUND_SYMBOLS + frameSymbols
+                             + (params.ack ? TURNAROUND_SYMBOLS + ackSymbols : 0) + ifsSymbols,
+                             params.slotted);
+    c.collisionSlots = ToSlots(TURNAROUND_SYMBOLS + frameSymbols
+                               + (params.ack ? ACK_WAIT_SYMBOLS : 0) + ifsSymbols,
+                               params.slotted);
+
+    CsmaCaModelResult result {};
+
+    // alpha가 커질수록 전송 시도가 줄어 다른 노드가 보는 alpha도 줄어들므로 고정점은 유일
+    // slotted에서는 alpha마다 같은 방식으로 beta의 고정점을 먼저 구함
+    auto solveBeta = [&](double alpha) {
+        if(!params.slotted)
+            return 0.0;
+        return Bisect(
+            [&](double beta) {
+                ChainState s = EvaluateChain(params, c, alpha, beta);
+                // CCA1이 idle인 슬롯에 다른 노드가 CCA2를 수행하면 다음 슬롯에서 전송이 시작됨
+                return 1 - std::pow(1 - s.tau * (1 - alpha), c.n - 1);
+            },
+            result.iterations);
+    };
+
+    double alpha = Bisect(
+        [&](double alpha) {
+            ChainState s = EvaluateChain(params, c, alpha, solveBeta(alpha));
+            // 다른 노드 중 하나 이상이 전송을 시작하면 busySlots 동안 채널이 점유됨
+            // (겹친 전송은 채널을 한 번만 점유하므로 Pollin et al.과 같이 "하나 이상" 확률을 사용)
+            return std::min(c.busySlots * s.pc, MAX_BUSY);
+        },
+        result.iterations);
+    double beta = solveBeta(alpha);
+    ChainState s = EvaluateChain(params, c, alpha, beta);
+
+    result.converged = std::fabs(std::min(c.busySlots * s.pc, MAX_BUSY) - alpha) < 1e-3;
+    result.tau = s.tau;
+    result.alpha = alpha;
+    result.beta = beta;
+    result.collisionProbability = s.pc;
+    result.accessFailureProbability = 1 - s.pTx;
+
+    // 재전송을 포함한 전달 확률: 충돌하면 CSMA-CA부터 다시 시작, 채널 접근 실패는 즉시 종료
+    double attempts = ExpectedAttempts(s.pTx * s.pc, c.retries);
+    result.reliability = attempts * s.pTx * (1 - s.pc);
+
+    result.throughput = c.n * s.q * (1 - s.pc) / c.slotSeconds;
+    result.throughputBps = result.throughput * params.payloadSize * 8;
+
+    // 전송한 시도 기준 평균 접근 지연: 단계 i에서 CCA를 통과할 확률 x^i (1 - x)
+    double ccaSlots = params.slotted ? 1 + (1 - alpha) : CCA_SYMBOLS / BACKOFF_PERIOD_SYMBOLS;
+    double accessSlots = 0;
+    double cumulative = 0;
+    double xi = 1;
+    for(double backoff : c.meanBackoff)
+    {
+        cumulative += backoff + ccaSlots;
+        accessSlots += xi * (1 - s.x) * cumulative;
+        xi *= s.x;
+    }
+    result.meanAccessDelay = s.pTx > 0 ? accessSlots / s.pTx * c.slotSeconds : 0;
+    result.meanServiceTime = attempts * s.expectedCycle * c.slotSeconds;
+
+    return result;
+}
@@ -0,0 +1,59 @@
+#ifndef LR_WPAN_CSMA_CA_MODEL_H
+#define LR_WPAN_CSMA_CA_MODEL_H
+
+#include <cstdint>
+
+/*
+ * IEEE 802.15.4 CSMA-CA 해석 모델 (slotted / unslotted)
+ *
+ * 단일 홉, 모든 노드가 서로의 CCA 범위 안에 있는 PAN을 가정한 고정점(fixed-point) 모델입니다.
+ * 태그 노드 하나의 백오프 단계를 마르코프 체인으로 보고(Pollin et al. 방식),
+ *  - tau   : 임의의 백오프 슬롯에서 노드가 (첫 번째) CCA를 수행할 확률
+ *  - alpha : CCA(slotted에서는 CCA1)에서 채널이 사용 중일 확률
+ *  - beta  : CCA1이 idle일 때 CCA2에서 채널이 사용 중일 확률 (slotted만)
+ * 가 서로 일치하는 고정점을 이분법으로 구합니다. 슬롯 길이는 aUnitBackoffPeriod(20 심볼)입니다.
+ *
+ * 비콘 전송 구간, CAP 경계에서의 전송 연기, 숨은 노드는 모델링하지 않습니다.
+ * 설정을 빠르게 걸러내기 위한 추정치이며 최종 결과는 시뮬레이션으로 확인해야 합니다.
+ */
+
+
+/// @brief 해석 모델 입력, 스크래치 시나리오에서 LrWpanCsmaCa / LrWpanMac에 설정하는 값과 같은 의미
+struct CsmaCaModelParams
+{
+    uint32_t nodeCount = 10;        ///< 경쟁하는 노드 수
+    bool slotted = false;           ///< SetSlottedCsmaCa() 여부
+    uint8_t macMinBE = 3;
+    uint8_t macMaxBE = 5;
+    uint8_t macMaxCSMABackoffs = 4;
+    uint8_t macMaxFrameRetries = 3; ///< ACK를 사용하지 않으면 무시됨
+    bool ack = true;                ///< TX_OPTION_ACK 여부
+    uint32_t payloadSize = 20;      ///< MSDU 크기 (byte)
+    double packetRate = 0;          ///< 노드별 패킷 도착률 (packet/s), 0이면 포화 상태
+};
+
+
+/// @brief 해석 모델 출력
+struct CsmaCaModelResult
+{
+    double tau;                     ///< 슬롯당 CCA 시도 확률
+    double alpha;                   ///< CCA(1)에서 채널 사용 중 확률
+    double beta;                    ///< CCA2에서 채널 사용 중 확률
+    double collisionProbability;    ///< 전송한 프레임이 충돌할 확률
+    double accessFailureProbability;///< 전송 시도 한 번이 CHANNEL_ACCESS_FAILURE로 끝날 확률
+    double reliability;             ///< 재전송을 포함해 패킷이 전달될 확률
+    double throughput;              ///< 전체 성공 프레임 수 (packet/s)
+    double throughputBps;           ///< 전체 MSDU 처리량 (bit/s)
+    double meanAccessDelay;         ///< 요청부터 전송 시작까지의 평균 지연 (s), 전송된 시도 기준
+    double meanServiceTime;         ///< 요청부터 MCPS-DATA.confirm까지의 평균 시간 (s)
+    uint32_t iterations;            ///< 고정점 탐색 중 백오프 체인을 계산한 횟수
+    bool converged;                 ///< 고정점 오차가 1e-3 미만인지 여부
+};
+
+
+/// @brief 고정점을 이분법으로 찾아 CSMA-CA 성능을 추정합니다. 설정 하나당 수~수백 마이크로초입니다.
+/// @param params CsmaCaModelParams
+/// @return CsmaCaModelResult
+CsmaCaModelResult SolveCsmaCaModel(const CsmaCaModelParams& params);
+
+#endif /* LR_WPAN_CSMA_CA_MODEL_H */
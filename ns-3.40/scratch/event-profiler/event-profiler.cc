@@ -0,0 +1,149 @@
+/*
+ * 이벤트 종류별 프로파일러 사용 예
+ *
+ * lr-wpan-superframe.cc처럼 비콘 모드 PAN(BO = SO = 6)을 만들고 디바이스들이 코디네이터에게
+ * 주기적으로 데이터를 보냅니다. --profile=true이면 ProfilingSimulatorImpl을 선택해
+ * CSMA-CA 백오프 타이머, PHY 수신 처리, 비콘 처리, 사용자 콜백 등이 각각 얼마나 시간을 쓰는지
+ * 보고서와 folded stack 파일(event-profile.folded)로 출력합니다.
+ *
+ * 다른 시나리오에서는 이 디렉터리의 profiling-simulator-impl.{h,cc}를 함께 빌드하고
+ * 아래 main()과 같이 SimulatorImplementationType만 바꾸면 됩니다.
+ *
+ * 사용 예:
+ *   ./ns3 run "event-profiler --nodes=200 --simTime=60"
+ *   flamegraph.pl event-profile.folded > event-profile.svg
+ */
+#include "profiling-simulator-impl.h"
+
+#include <ns3/core-module.h>
+#include <ns3/lr-wpan-module.h>
+#include <ns3/mobility-module.h>
+#include <ns3/network-module.h>
+#include <ns3/simulator.h>
+
+#include <chrono>
+#include <iostream>
+
+using namespace ns3;
+
+const int COORDINATOR_PAN_ID = 5;
+
+static uint64_t g_delivered = 0;
+
+
+static void
+McpsDataIndication(McpsDataIndicationParams params, Ptr<Packet> p)
+{
+    g_delivered++;
+}
+
+
+/// @brief 코디네이터에게 주기적으로 데이터를 보냅니다.
+/// @param mac Ptr<LrWpanMac>
+/// @param interval 전송 간격
+static void
+SendData(Ptr<LrWpanMac> mac, Time interval)
+{
+    static uint8_t msduHandle = 0;
+
+    McpsDataRequestParams params;
+    params.m_dstPanId = COORDINATOR_PAN_ID;
+    params.m_srcAddrMode = SHORT_ADDR;
+    params.m_dstAddrMode = SHORT_ADDR;
+    params.m_dstAddr = Mac16Address("00:01");
+    params.m_msduHandle = msduHandle++;
+    params.m_txOptions = TX_OPTION_ACK;
+
+    mac->McpsDataRequest(params, Create<Packet>(20));
+
+    Simulator::Schedule(interval, &SendData, mac, interval);
+}
+
+
+int main(int argc, char* argv[])
+{
+    bool profile = true;
+    uint32_t nodeCount = 50;
+    double interval = 1.0;
+    double simTime = 30;
+    std::string report;
+    std::string folded = "event-profile.folded";
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("profile", "이벤트 프로파일러 사용 여부", profile);
+    cmd.AddValue("nodes", "코디네이터를 포함한 노드 수", nodeCount);
+    cmd.AddValue("interval", "디바이스별 전송 간격 (s)", interval);
+    cmd.AddValue("simTime", "시뮬레이션 시간 (s)", simTime);
+    cmd.AddValue("report", "보고서 파일, 비어 있으면 표준 출력", report);
+    cmd.AddValue("folded", "folded stack 파일, 비어 있으면 쓰지 않음", folded);
+    cmd.Parse(argc, argv);
+
+    // 시뮬레이터가 만들어지기 전(첫 Schedule 전)에 구현 타입을 바꿔야 함
+    if(profile)
+    {
+        GlobalValue::Bind("SimulatorImplementationType", StringValue("ns3::ProfilingSimulatorImpl"));
+        Config::SetDefault("ns3::ProfilingSimulatorImpl::ReportFile", StringValue(report));
+        Config::SetDefault("ns3::ProfilingSimulatorImpl::FoldedFile", StringValue(folded));
+    }
+
+    NodeContainer pan;
+    pan.Create(nodeCount);
+
+    MobilityHelper mobilityHelper;
+    mobilityHelper.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+    mobilityHelper.SetPositionAllocator("ns3::UniformDiscPositionAllocator",
+                                        "rho", DoubleValue(20.0));
+    mobilityHelper.Install(pan);
+
+    LrWpanHelper lrWpanHelper;
+    NetDeviceContainer netDevices = lrWpanHelper.Install(pan);
+    lrWpanHelper.CreateAssociatedPan(netDevices, COORDINATOR_PAN_ID);
+
+    Ptr<LrWpanNetDevice> coordinator = DynamicCast<LrWpanNetDevice>(netDevices.Get(0));
+    coordinator->GetMac()->SetMcpsDataIndicationCallback(MakeCallback(&McpsDataIndication));
+
+    MlmeStartRequestParams startParams;
+    startParams.m_panCoor = true;
+    startParams.m_PanId = COORDINATOR_PAN_ID;
+    startParams.m_bcnOrd = 6;
+    startParams.m_sfrmOrd = 6;
+    Simulator::ScheduleWithContext(coordinator->GetNode()->GetId(),
+                                   Seconds(0),
+                                   &LrWpanMac::MlmeStartRequest,
+                                   coordinator->GetMac(),
+                                   startParams);
+
+    Ptr<UniformRandomVariable> jitter = CreateObject<UniformRandomVariable>();
+    for(uint32_t i = 1; i < netDevices.GetN(); i++)
+    {
+        Ptr<LrWpanNetDevice> netDevice = DynamicCast<LrWpanNetDevice>(netDevices.Get(i));
+
+        MlmeSyncRequestParams syncParams;
+        syncParams.m_logCh = 11;
+        syncParams.m_trackBcn = true;
+        Simulator::ScheduleWithContext(netDevice->GetNode()->GetId(),
+                                       Seconds(0.5),
+                                       &LrWpanMac::MlmeSyncRequest,
+                                       netDevice->GetMac(),
+                                       syncParams);
+
+        Simulator::ScheduleWithContext(netDevice->GetNode()->GetId(),
+                                       Seconds(2 + jitter->GetValue(0, interval)),
+                                       &SendData,
+                                       netDevice->GetMac(),
+                                       Seconds(interval));
+    }
+
+    Simulator::Stop(Seconds(simTime));
+
+    auto wallStart = std::chrono::steady_clock::now();
+    Simulator::Run();
+    double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+
+    std::cout << "delivered " << g_delivered << " frames in " << wallSeconds << " s wall-clock" << std::endl;
+
+    // 프로파일러 보고서는 Destroy() 시 출력됨
+    Simulator::Destroy();
+
+    return 0;
+}
@@ -0,0 +1,411 @@
+#include "profiling-simulator-impl.h"
+
+#include <ns3/log.h>
+#include <ns3/string.h>
+#include <ns3/uinteger.h>
+
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <execinfo.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("ProfilingSimulatorImpl");
+
+NS_OBJECT_ENSURE_REGISTERED(ProfilingSimulatorImpl);
+
+namespace
+{
+
+/// @brief TSC 값을 읽습니다. x86이 아니면 steady_clock 나노초를 대신 사용합니다.
+inline uint64_t
+ReadTicks()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return std::chrono::steady_clock::now().time_since_epoch().count();
+#endif
+}
+
+
+/// 이 스레드에서 Wrap()에 쓴 TSC 틱 누적값, 실행 중인 이벤트의 시간에서 뺌
+thread_local uint64_t t_wrapTicks = 0;
+
+
+int64_t
+NowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+
+/// @brief 다른 이벤트를 감싸 실행 시간을 재는 이벤트
+class ProfiledEvent : public EventImpl
+{
+  public:
+    ProfiledEvent(ProfilingSimulatorImpl* profiler, EventImpl* event, void* const* frames, int depth)
+        : m_profiler(profiler),
+          m_event(event, false),
+          m_depth(depth)
+    {
+        std::copy(frames, frames + depth, m_frames);
+    }
+
+  protected:
+    void Notify() override
+    {
+        // 이벤트 안에서 다른 이벤트를 예약하며 쓴 스택 캡처 비용은 프로파일러의 비용이므로 제외
+        uint64_t wrapTicks = t_wrapTicks;
+        uint64_t start = ReadTicks();
+        m_event->Invoke();
+        uint64_t ticks = ReadTicks() - start;
+        uint64_t overhead = t_wrapTicks - wrapTicks;
+        m_profiler->Record(PeekPointer(m_event), m_frames, m_depth, ticks > overhead ? ticks - overhead : 0);
+    }
+
+  private:
+    ProfilingSimulatorImpl* m_profiler;
+    Ptr<EventImpl> m_event;
+    void* m_frames[ProfilingSimulatorImpl::SITE_DEPTH];   ///< 예약 시 호출 스택
+    int m_depth;
+};
+
+
+/// @brief 첫 번째 템플릿 인자를 꺼냅니다. "MakeEvent<A, B>(...)"에서 A
+/// @return 찾지 못하면 빈 문자열
+std::string
+FirstTemplateArgument(const std::string& name, size_t open)
+{
+    int depth = 0;
+    for(size_t i = open + 1; i < name.size(); i++)
+    {
+        char c = name[i];
+        if(c == '<' || c == '(')
+            depth++;
+        else if((c == '>' || c == ')') && depth > 0)
+            depth--;
+        else if((c == ',' || c == '>') && depth == 0)
+            return name.substr(open + 1, i - open - 1);
+    }
+    return "";
+}
+
+
+/// @brief 이벤트 타입 이름에서 대상 클래스와 함수 시그니처를 뽑습니다.
+/// @param mangled typeid().name()
+/// @param className 멤버 함수의 클래스, 일반 함수면 빈 문자열
+/// @param signature 함수 시그니처
+void
+DescribeEvent(const char* mangled, std::string& className, std::string& signature)
+{
+    int status = 0;
+    char* demangled = abi::__cxa_demangle(mangled, nullptr, nullptr, &status);
+    std::string name = status == 0 ? demangled : mangled;
+    std::free(demangled);
+
+    // MakeEvent<void (ns3::LrWpanCsmaCa::*)(), ns3::Ptr<ns3::LrWpanCsmaCa>>(...)::EventMemberImpl
+    size_t makeEvent = name.find("MakeEvent<");
+    signature = makeEvent == std::string::npos ? "" : FirstTemplateArgument(name, makeEvent + 9);
+    if(signature.empty())
+    {
+        signature = name;
+        className.clear();
+        return;
+    }
+
+    size_t member = signature.find("::*)");
+    size_t open = signature.rfind('(', member);
+    if(member != std::string::npos && open != std::string::npos)
+        className = signature.substr(open + 1, member - open - 1);
+    else
+        className.clear();
+}
+
+
+/// @brief 반환 주소가 Simulator / SimulatorImpl / MakeEvent 안인지 확인합니다.
+bool
+IsInternalFrame(void* address)
+{
+    // 반환 주소는 call 다음 명령이므로 1을 빼서 호출한 함수 안을 가리키게 함
+    Dl_info info;
+    if(!dladdr(static_cast<char*>(address) - 1, &info) || !info.dli_sname)
+        return false;
+
+    static const char* const prefixes[] = {
+        "_ZN3ns39Simulator",
+        "_ZN3ns39MakeEvent",
+        "_ZN3ns320DefaultSimulatorImpl",
+        "_ZN3ns321RealtimeSimulatorImpl",
+        "_ZN3ns322ProfilingSimulatorImpl",
+    };
+    for(const char* prefix : prefixes)
+    {
+        if(std::strncmp(info.dli_sname, prefix, std::strlen(prefix)) == 0)
+            return true;
+    }
+    return false;
+}
+
+
+/// @brief 반환 주소를 함수 이름으로 바꿉니다. 심볼이 없으면 "모듈+오프셋"
+std::string
+DescribeSite(void* address)
+{
+    if(!address)
+        return "(unknown)";
+
+    Dl_info info;
+    char* target = static_cast<char*>(address) - 1;
+    if(!dladdr(target, &info))
+        return "(unknown)";
+
+    if(info.dli_sname)
+    {
+        int status = 0;
+        char* demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+        std::string name = status == 0 ? demangled : info.dli_sname;
+        std::free(demangled);
+        return name;
+    }
+
+    std::string module = info.dli_fname ? info.dli_fname : "?";
+    size_t slash = module.rfind('/');
+    if(slash != std::string::npos)
+        module = module.substr(slash + 1);
+
+    std::ostringstream os;
+    os << module << "+0x" << std::hex << (target - static_cast<char*>(info.dli_fbase));
+    return os.str();
+}
+
+} // namespace
+
+
+TypeId
+ProfilingSimulatorImpl::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::ProfilingSimulatorImpl")
+            .SetParent<DefaultSimulatorImpl>()
+            .SetGroupName("Core")
+            .AddConstructor<ProfilingSimulatorImpl>()
+            .AddAttribute("ReportFile",
+                          "File for the sorted per-event-type report, empty for stdout",
+                          StringValue(""),
+                          MakeStringAccessor(&ProfilingSimulatorImpl::m_reportFile),
+                          MakeStringChecker())
+            .AddAttribute("FoldedFile",
+                          "File for flame graph folded stacks (microseconds), empty to disable",
+                          StringValue("event-profile.folded"),
+                          MakeStringAccessor(&ProfilingSimulatorImpl::m_foldedFile),
+                          MakeStringChecker())
+            .AddAttribute("Top",
+                          "Maximum number of event types printed in the report",
+                          UintegerValue(30),
+                          MakeUintegerAccessor(&ProfilingSimulatorImpl::m_top),
+                          MakeUintegerChecker<uint32_t>());
+    return tid;
+}
+
+
+ProfilingSimulatorImpl::ProfilingSimulatorImpl()
+    : m_top(30),
+      m_startTicks(ReadTicks()),
+      m_startNs(NowNs()),
+      m_reported(false)
+{
+    NS_LOG_FUNCTION(this);
+
+    // 첫 backtrace()는 unwinder를 불러오며 할당하므로 미리 한 번 호출
+    void* frames[1];
+    backtrace(frames, 1);
+}
+
+
+ProfilingSimulatorImpl::~ProfilingSimulatorImpl()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+
+void
+ProfilingSimulatorImpl::Destroy()
+{
+    NS_LOG_FUNCTION(this);
+    if(!m_reported)
+    {
+        WriteReport();
+        m_reported = true;
+    }
+    DefaultSimulatorImpl::Destroy();
+}
+
+
+EventId
+ProfilingSimulatorImpl::Schedule(const Time& delay, EventImpl* event)
+{
+    return DefaultSimulatorImpl::Schedule(delay, Wrap(event));
+}
+
+
+void
+ProfilingSimulatorImpl::ScheduleWithContext(uint32_t context, const Time& delay, EventImpl* event)
+{
+    DefaultSimulatorImpl::ScheduleWithContext(context, delay, Wrap(event));
+}
+
+
+EventId
+ProfilingSimulatorImpl::ScheduleNow(EventImpl* event)
+{
+    return DefaultSimulatorImpl::ScheduleNow(Wrap(event));
+}
+
+
+__attribute__((noinline)) EventImpl*
+ProfilingSimulatorImpl::Wrap(EventImpl* event)
+{
+    // 다른 스레드에서 ScheduleWithContext()가 불려도 안전하도록 공유 상태는 건드리지 않고 스택만 잡음.
+    // 앞의 두 프레임은 Wrap()과 Schedule*() 오버라이드이므로 버림
+    uint64_t start = ReadTicks();
+
+    void* frames[SITE_DEPTH + 2];
+    int depth = backtrace(frames, SITE_DEPTH + 2);
+    depth = std::max(depth - 2, 0);
+    EventImpl* wrapped = new ProfiledEvent(this, event, frames + 2, depth);
+
+    t_wrapTicks += ReadTicks() - start;
+    return wrapped;
+}
+
+
+void*
+ProfilingSimulatorImpl::FindSite(void* const* frames, int depth)
+{
+    for(int i = 0; i < depth; i++)
+    {
+        auto it = m_internalFrames.find(frames[i]);
+        if(it == m_internalFrames.end())
+            it = m_internalFrames.emplace(frames[i], IsInternalFrame(frames[i])).first;
+        if(!it->second)
+            return frames[i];
+    }
+
+    // 스택이 모두 Simulator 안이면(깊이 부족) 가장 바깥 프레임
+    return depth ? frames[depth - 1] : nullptr;
+}
+
+
+void
+ProfilingSimulatorImpl::Record(const EventImpl* event, void* const* frames, int depth, uint64_t ticks)
+{
+    std::pair<std::type_index, void*> key(typeid(*event), FindSite(frames, depth));
+    auto it = m_index.find(key);
+    if(it == m_index.end())
+    {
+        Entry entry;
+        DescribeEvent(key.first.name(), entry.className, entry.signature);
+        entry.site = DescribeSite(key.second);
+        it = m_index.emplace(key, m_entries.size()).first;
+        m_entries.push_back(entry);
+    }
+
+    Entry& entry = m_entries[it->second];
+    entry.calls++;
+    entry.ticks += ticks;
+}
+
+
+void
+ProfilingSimulatorImpl::WriteReport()
+{
+    // TSC 주파수를 생성 시점부터의 steady_clock 경과 시간으로 환산
+    uint64_t elapsedTicks = ReadTicks() - m_startTicks;
+    int64_t elapsedNs = NowNs() - m_startNs;
+    double nsPerTick = elapsedTicks ? static_cast<double>(elapsedNs) / elapsedTicks : 1.0;
+
+    std::vector<const Entry*> sorted;
+    uint64_t totalTicks = 0;
+    uint64_t totalCalls = 0;
+    for(const Entry& entry : m_entries)
+    {
+        sorted.push_back(&entry);
+        totalTicks += entry.ticks;
+        totalCalls += entry.calls;
+    }
+    std::sort(sorted.begin(), sorted.end(), [](const Entry* a, const Entry* b) {
+        return a->ticks > b->ticks;
+    });
+
+    std::ofstream file;
+    if(!m_reportFile.empty())
+        file.open(m_reportFile);
+    std::ostream& os = file.is_open() ? file : std::cout;
+
+    os << "event profile: " << totalCalls << " events, "
+       << std::fixed << std::setprecision(3) << totalTicks * nsPerTick / 1e6 << " ms in events, "
+       << elapsedNs / 1e6 << " ms wall-clock" << std::endl;
+    os << std::right
+       << std::setw(8) << "%"
+       << std::setw(14) << "total(ms)"
+       << std::setw(12) << "calls"
+       << std::setw(12) << "ns/call"
+       << "  scheduled from -> event signature" << std::endl;
+
+    uint32_t printed = 0;
+    for(const Entry* entry : sorted)
+    {
+        if(printed++ >= m_top)
+            break;
+        os << std::setw(8) << std::setprecision(2) << (totalTicks ? 100.0 * entry->ticks / totalTicks : 0)
+           << std::setw(14) << std::setprecision(3) << entry->ticks * nsPerTick / 1e6
+           << std::setw(12) << entry->calls
+           << std::setw(12) << std::setprecision(1) << entry->ticks * nsPerTick / entry->calls
+           << "  " << entry->site << " -> "
+           << (entry->className.empty() ? "" : entry->className + " ") << entry->signature
+           << std::endl;
+    }
+
+    if(m_foldedFile.empty())
+        return;
+
+    std::ofstream folded(m_foldedFile);
+    if(!folded)
+    {
+        NS_LOG_WARN("cannot open " << m_foldedFile);
+        return;
+    }
+
+    // flame graph의 ';'는 스택 구분자이므로 이름 안의 ';'는 바꿔 둠
+    auto frame = [](std::string name) {
+        std::replace(name.begin(), name.end(), ';', ',');
+        return name;
+    };
+    for(const Entry& entry : m_entries)
+    {
+        folded << "Simulator::Run;" << frame(entry.site);
+        if(!entry.className.empty())
+            folded << ';' << frame(entry.className);
+        folded << ';' << frame(entry.signature)
+               << ' ' << static_cast<uint64_t>(entry.ticks * nsPerTick / 1e3) << '\n';
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,110 @@
+#ifndef PROFILING_SIMULATOR_IMPL_H
+#define PROFILING_SIMULATOR_IMPL_H
+
+#include <ns3/default-simulator-impl.h>
+
+#include <cstdint>
+#include <string>
+#include <typeindex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/*
+ * 이벤트 종류별 wall-clock 프로파일러
+ *
+ * DefaultSimulatorImpl을 그대로 상속하고, 예약되는 이벤트마다 실행 시간을 재는 래퍼를 씌웁니다.
+ * 시간은 TSC(rdtsc)로 재고 종료 시 steady_clock으로 환산합니다.
+ *
+ * 이벤트의 태그는 (예약한 곳, 이벤트 시그니처) 쌍입니다.
+ *  - 예약한 곳: 이벤트를 예약할 때 backtrace()로 호출 스택을 잡아 두고, Simulator / SimulatorImpl /
+ *    MakeEvent 프레임을 건너뛴 첫 프레임을 dladdr()로 함수 이름으로 바꿉니다.
+ *    예: LrWpanCsmaCa::Start()가 예약한 RandomBackoffDelay와 RandomBackoffDelay()가 예약한 CanProceed는
+ *    시그니처(LrWpanCsmaCa의 void ())가 같아도 서로 다른 행이 됩니다. 람다 / std::function 이벤트도 같습니다.
+ *  - 이벤트 시그니처: MakeEvent()가 만든 EventImpl의 타입에서 얻습니다. 멤버 함수 이벤트는 대상 클래스와
+ *    함수 시그니처, 일반 함수 이벤트는 MakeEvent의 첫 템플릿 인자(ns-3.40에서는 첫 매개변수 타입)입니다.
+ *    시그니처만으로는 실행되는 함수를 구분할 수 없으므로 보조 정보로만 씁니다.
+ * 동적 심볼 테이블에 없는 함수(-rdynamic 없이 빌드한 실행 파일의 static 함수 등)는 "모듈+오프셋"으로 표시되며
+ * addr2line으로 위치를 찾을 수 있습니다. 예약마다 스택을 잡으므로 예약 비용이 1 us 정도 늘어납니다.
+ * 이 비용은 스레드별로 누적해 두었다가, 예약한 이벤트의 실행 시간에서 빼므로 보고서에는 들어가지 않습니다.
+ *
+ * 사용하려면 시뮬레이터를 만들기 전에 구현 타입을 바꿉니다.
+ *   GlobalValue::Bind("SimulatorImplementationType", StringValue("ns3::ProfilingSimulatorImpl"));
+ * 선택하지 않으면 DefaultSimulatorImpl이 그대로 쓰이므로 추가 비용이 전혀 없습니다.
+ *
+ * Simulator::Destroy() 시 총 시간 순으로 정렬한 보고서와
+ * flamegraph.pl / speedscope에서 읽을 수 있는 folded stack 파일(값: 마이크로초)을 씁니다.
+ */
+
+namespace ns3
+{
+
+/// @brief 이벤트 종류별 실행 횟수 / 시간을 누적하는 SimulatorImpl
+class ProfilingSimulatorImpl : public DefaultSimulatorImpl
+{
+  public:
+    static TypeId GetTypeId();
+
+    ProfilingSimulatorImpl();
+    ~ProfilingSimulatorImpl() override;
+
+    void Destroy() override;
+    EventId Schedule(const Time& delay, EventImpl* event) override;
+    void ScheduleWithContext(uint32_t context, const Time& delay, EventImpl* event) override;
+    EventId ScheduleNow(EventImpl* event) override;
+
+    /// @brief 예약 시 잡아 두는 호출 스택 깊이
+    static constexpr int SITE_DEPTH = 8;
+
+    /// @brief 실행된 이벤트 하나를 누적합니다. 래퍼 이벤트가 호출합니다.
+    /// @param event 실제 이벤트
+    /// @param frames 예약 시 호출 스택(반환 주소)
+    /// @param depth frames의 유효한 길이
+    /// @param ticks 실행에 걸린 TSC 틱
+    void Record(const EventImpl* event, void* const* frames, int depth, uint64_t ticks);
+
+  private:
+    /// @brief 태그 하나의 누적값
+    struct Entry
+    {
+        std::string site;       ///< 예약한 함수
+        std::string className;  ///< 대상 클래스, 일반 함수 이벤트는 빈 문자열
+        std::string signature;  ///< 함수 시그니처
+        uint64_t calls = 0;
+        uint64_t ticks = 0;
+    };
+
+    /// @brief 이벤트를 시간 측정 래퍼로 감싸고 예약한 곳의 호출 스택을 잡아 둡니다.
+    EventImpl* Wrap(EventImpl* event);
+
+    /// @brief 호출 스택에서 Simulator 내부가 아닌 첫 프레임을 고릅니다.
+    void* FindSite(void* const* frames, int depth);
+
+    /// @brief (이벤트 타입, 예약한 곳) 태그 키의 해시
+    struct KeyHash
+    {
+        size_t operator()(const std::pair<std::type_index, void*>& key) const
+        {
+            return key.first.hash_code() ^ (std::hash<void*>()(key.second) << 1);
+        }
+    };
+
+    /// @brief 보고서와 folded stack 파일을 씁니다.
+    void WriteReport();
+
+    std::string m_reportFile;   ///< 비어 있으면 표준 출력
+    std::string m_foldedFile;   ///< 비어 있으면 쓰지 않음
+    uint32_t m_top;             ///< 보고서에 출력할 최대 태그 수
+
+    std::vector<Entry> m_entries;
+    std::unordered_map<std::pair<std::type_index, void*>, uint32_t, KeyHash> m_index;  ///< 태그 -> m_entries 인덱스
+    std::unordered_map<void*, bool> m_internalFrames;   ///< 반환 주소 -> Simulator 내부 프레임 여부
+
+    uint64_t m_startTicks;
+    int64_t m_startNs;
+    bool m_reported;
+};
+
+} // namespace ns3
+
+#endif /* PROFILING_SIMULATOR_IMPL_H */
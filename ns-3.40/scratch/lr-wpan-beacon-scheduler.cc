@@ -0,0 +1,401 @@
+/*
+ * 같은 채널을 쓰는 비콘 모드 코디네이터의 슈퍼프레임 오프셋 스케줄링
+ *
+ * 여러 코디네이터가 같은 채널에서 MlmeStartRequest(m_bcnOrd / m_sfrmOrd)로 비콘 PAN을 시작하면
+ * 비콘과 활성 구간(CAP)이 겹쳐 비콘을 놓치고 처리량이 무너집니다.
+ * BO > SO이면 비콘 간격(BI) 안에 활성 구간(SD)이 2^(BO - SO)개 들어갈 수 있으므로,
+ * 서로 간섭하는 PAN끼리 다른 SD 슬롯을 쓰도록 시작 시각을 어긋나게 합니다.
+ *
+ * 1. 코디네이터 사이 거리가 --interferenceRange 이하이면 간섭 그래프에 간선을 둡니다.
+ * 2. DSatur 탐욕 색칠로 색을 정하고, 색 c인 PAN의 슈퍼프레임 오프셋을 c * SD로 둡니다.
+ *    색 수가 2^(BO - SO)를 넘으면 슬롯을 재사용하고 경고를 출력합니다.
+ * 3. 같은 위치 / 트래픽으로 aligned(모두 같은 시각), random(무작위 오프셋), colored를 비교해
+ *    PAN별 / 전체 처리량과 비콘 동기 손실(MLME-SYNC-LOSS.indication) 수를 출력합니다.
+ *
+ * StartTime(MlmeStartRequestParams::m_StartTime)은 상위 코디네이터의 비콘(들어오는 슈퍼프레임)을
+ * 기준으로 한 값이라 PAN 코디네이터에는 적용되지 않습니다. 여기서는 코디네이터가 모두 독립된
+ * PAN 코디네이터이므로, 공통 기준 시각 + 오프셋에 MLME-START.request를 보내 나가는(outgoing)
+ * 슈퍼프레임의 시작을 맞춥니다. 비콘은 이후 BI마다 반복되므로 오프셋이 유지됩니다.
+ *
+ * 사용 예:
+ *   ./ns3 run "lr-wpan-beacon-scheduler --pans=9 --bo=8 --so=5 --mode=all"
+ */
+#include <ns3/core-module.h>
+#include <ns3/lr-wpan-module.h>
+#include <ns3/simulator.h>
+
+#include <ns3/network-module.h>
+
+// channel
+#include <ns3/propagation-module.h>
+#include <ns3/spectrum-module.h>
+
+// mobility model
+#include <ns3/mobility-helper.h>
+#include <ns3/mobility-module.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <set>
+#include <vector>
+
+using namespace ns3;
+
+const int COORDINATOR_CHANNEL = 11;
+
+/// aBaseSuperframeDuration (심볼), 2.4 GHz O-QPSK 심볼 길이 (us)
+const uint32_t BASE_SUPERFRAME_DURATION = 960;
+const uint32_t SYMBOL_DURATION_US = 16;
+
+
+/// @brief 실행 설정
+struct SchedulerOptions
+{
+    uint32_t panCount = 9;
+    uint32_t devicesPerPan = 5;
+    double panSpacing = 60;             ///< 코디네이터 격자 간격 (m)
+    double panRadius = 15;              ///< 디바이스 배치 반경 (m)
+    double interferenceRange = 100;     ///< 간섭 그래프 간선 기준 거리 (m)
+    uint8_t bcnOrd = 8;
+    uint8_t sfrmOrd = 5;
+    double interval = 0.5;              ///< 디바이스별 전송 간격 (s)
+    uint32_t payloadSize = 30;
+    double simTime = 60;
+};
+
+
+/// @brief PAN 하나의 상태
+struct PanInfo
+{
+    Vector position;
+    uint32_t color = 0;
+    Time offset;
+    uint64_t receivedBytes = 0;
+    uint32_t receivedPackets = 0;
+    uint32_t sent = 0;
+    uint32_t syncLoss = 0;
+};
+
+static std::vector<PanInfo> g_pans;
+
+
+/// @brief 슈퍼프레임 길이 SD = aBaseSuperframeDuration * 2^SO 심볼
+static Time
+SuperframeDuration(uint8_t sfrmOrd)
+{
+    return MicroSeconds(static_cast<uint64_t>(SYMBOL_DURATION_US) * (BASE_SUPERFRAME_DURATION << sfrmOrd));
+}
+
+
+/// @brief 간섭 그래프를 DSatur로 색칠합니다.
+/// 색이 정해지지 않은 정점 중 이웃 색의 종류(포화도)가 가장 많은 정점부터, 이웃이 쓰지 않은 가장 작은 색을 줍니다.
+/// @param adjacency 인접 리스트
+/// @return 정점별 색 (0부터)
+static std::vector<uint32_t>
+ColorGraph(const std::vector<std::vector<uint32_t>>& adjacency)
+{
+    const uint32_t uncolored = UINT32_MAX;
+    uint32_t n = adjacency.size();
+    std::vector<uint32_t> colors(n, uncolored);
+    std::vector<std::set<uint32_t>> neighbourColors(n);
+
+    for(uint32_t step = 0; step < n; step++)
+    {
+        // 포화도, 동률이면 차수가 큰 정점
+        uint32_t pick = uncolored;
+        for(uint32_t v = 0; v < n; v++)
+        {
+            if(colors[v] != uncolored)
+                continue;
+            if(pick == uncolored ||
+               neighbourColors[v].size() > neighbourColors[pick].size() ||
+               (neighbourColors[v].size() == neighbourColors[pick].size() && adjacency[v].size() > adjacency[pick].size()))
+                pick = v;
+        }
+
+        uint32_t color = 0;
+        while(neighbourColors[pick].count(color))
+            color++;
+        colors[pick] = color;
+        for(uint32_t u : adjacency[pick])
+            neighbourColors[u].insert(color);
+    }
+    return colors;
+}
+
+
+static void
+CoordinatorDataIndication(uint32_t pan, McpsDataIndicationParams params, Ptr<Packet> p)
+{
+    g_pans[pan].receivedBytes += p->GetSize();
+    g_pans[pan].receivedPackets++;
+}
+
+
+static void
+MlmeSyncLossIndication(uint32_t pan, MlmeSyncLossIndicationParams params)
+{
+    g_pans[pan].syncLoss++;
+}
+
+
+/// @brief 코디네이터에게 주기적으로 데이터를 보냅니다.
+static void
+SendData(uint32_t pan, Ptr<LrWpanMac> mac, Mac16Address coordinator, uint32_t payloadSize, Time interval)
+{
+    static uint8_t msduHandle = 0;
+
+    McpsDataRequestParams params;
+    params.m_dstPanId = mac->GetPanId();
+    params.m_srcAddrMode = SHORT_ADDR;
+    params.m_dstAddrMode = SHORT_ADDR;
+    params.m_dstAddr = coordinator;
+    params.m_msduHandle = msduHandle++;
+    params.m_txOptions = TX_OPTION_ACK;
+
+    mac->McpsDataRequest(params, Create<Packet>(payloadSize));
+    g_pans[pan].sent++;
+
+    Simulator::Schedule(interval, &SendData, pan, mac, coordinator, payloadSize, interval);
+}
+
+
+/// @brief 정해진 오프셋으로 모든 PAN을 실행합니다. g_pans의 offset을 사용합니다.
+static void
+Run(const SchedulerOptions& options)
+{
+    for(PanInfo& pan : g_pans)
+    {
+        pan.receivedBytes = 0;
+        pan.receivedPackets = 0;
+        pan.sent = 0;
+        pan.syncLoss = 0;
+    }
+    RngSeedManager::SetSeed(1);
+    RngSeedManager::SetRun(1);
+
+    Ptr<SingleModelSpectrumChannel> channel = CreateObject<SingleModelSpectrumChannel>();
+    channel->AddPropagationLossModel(CreateObject<LogDistancePropagationLossModel>());
+    channel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
+
+    LrWpanHelper lrWpanHelper;
+    lrWpanHelper.SetChannel(channel);
+
+    // 모든 PAN의 비콘 시작 기준 시각
+    Time base = Seconds(1.0);
+    Time beaconInterval = SuperframeDuration(options.bcnOrd);
+    Time warmup = base + beaconInterval * 3;
+    Ptr<UniformRandomVariable> jitter = CreateObject<UniformRandomVariable>();
+
+    for(uint32_t p = 0; p < g_pans.size(); p++)
+    {
+        NodeContainer nodes;
+        nodes.Create(options.devicesPerPan + 1);
+
+        MobilityHelper mobilityHelper;
+        mobilityHelper.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+        mobilityHelper.SetPositionAllocator("ns3::UniformDiscPositionAllocator",
+                                            "X", DoubleValue(g_pans[p].position.x),
+                                            "Y", DoubleValue(g_pans[p].position.y),
+                                            "rho", DoubleValue(options.panRadius));
+        mobilityHelper.Install(nodes);
+        nodes.Get(0)->GetObject<MobilityModel>()->SetPosition(g_pans[p].position);
+
+        NetDeviceContainer netDevices = lrWpanHelper.Install(nodes);
+        lrWpanHelper.CreateAssociatedPan(netDevices, p + 1);
+
+        Ptr<LrWpanNetDevice> coordinator = DynamicCast<LrWpanNetDevice>(netDevices.Get(0));
+        coordinator->GetMac()->SetMcpsDataIndicationCallback(MakeBoundCallback(&CoordinatorDataIndication, p));
+
+        MlmeStartRequestParams startParams;
+        startParams.m_panCoor = true;
+        startParams.m_PanId = p + 1;
+        startParams.m_bcnOrd = options.bcnOrd;
+        startParams.m_sfrmOrd = options.sfrmOrd;
+        startParams.m_logCh = COORDINATOR_CHANNEL;
+        startParams.m_coorRealgn = false;
+        Simulator::ScheduleWithContext(nodes.Get(0)->GetId(),
+                                       base + g_pans[p].offset,
+                                       &LrWpanMac::MlmeStartRequest,
+                                       coordinator->GetMac(),
+                                       startParams);
+
+        for(uint32_t i = 1; i < netDevices.GetN(); i++)
+        {
+            Ptr<LrWpanNetDevice> netDevice = DynamicCast<LrWpanNetDevice>(netDevices.Get(i));
+            netDevice->GetMac()->SetMlmeSyncLossIndicationCallback(MakeBoundCallback(&MlmeSyncLossIndication, p));
+
+            MlmeSyncRequestParams syncParams;
+            syncParams.m_logCh = COORDINATOR_CHANNEL;
+            syncParams.m_trackBcn = true;
+            Simulator::ScheduleWithContext(nodes.Get(i)->GetId(),
+                                           base - MilliSeconds(100),
+                                           &LrWpanMac::MlmeSyncRequest,
+                                           netDevice->GetMac(),
+                                           syncParams);
+
+            Simulator::ScheduleWithContext(nodes.Get(i)->GetId(),
+                                           warmup + Seconds(jitter->GetValue(0, options.interval)),
+                                           &SendData,
+                                           p,
+                                           netDevice->GetMac(),
+                                           coordinator->GetMac()->GetShortAddress(),
+                                           options.payloadSize,
+                                           Seconds(options.interval));
+        }
+    }
+
+    Simulator::Stop(warmup + Seconds(options.simTime));
+    Simulator::Run();
+    Simulator::Destroy();
+}
+
+
+/// @brief 실행 결과를 출력합니다.
+static void
+PrintResult(const std::string& title, const SchedulerOptions& options)
+{
+    uint64_t totalBytes = 0;
+    uint32_t totalSent = 0;
+    uint32_t totalReceived = 0;
+    uint32_t totalSyncLoss = 0;
+
+    std::cout << std::endl << title << std::endl
+              << std::right
+              << std::setw(5) << "PAN"
+              << std::setw(7) << "color"
+              << std::setw(13) << "offset(ms)"
+              << std::setw(8) << "sent"
+              << std::setw(10) << "received"
+              << std::setw(10) << "ratio%"
+              << std::setw(12) << "kbps"
+              << std::setw(11) << "sync loss"
+              << std::endl;
+
+    for(uint32_t p = 0; p < g_pans.size(); p++)
+    {
+        const PanInfo& pan = g_pans[p];
+        std::cout << std::fixed
+                  << std::setw(5) << p + 1
+                  << std::setw(7) << pan.color
+                  << std::setw(13) << std::setprecision(2) << pan.offset.GetSeconds() * 1e3
+                  << std::setw(8) << pan.sent
+                  << std::setw(10) << pan.receivedPackets
+                  << std::setw(10) << std::setprecision(1) << (pan.sent ? 100.0 * pan.receivedPackets / pan.sent : 0)
+                  << std::setw(12) << std::setprecision(3) << pan.receivedBytes * 8 / options.simTime / 1e3
+                  << std::setw(11) << pan.syncLoss
+                  << std::endl;
+
+        totalBytes += pan.receivedBytes;
+        totalSent += pan.sent;
+        totalReceived += pan.receivedPackets;
+        totalSyncLoss += pan.syncLoss;
+    }
+
+    std::cout << "total: " << totalReceived << "/" << totalSent << " packets ("
+              << std::setprecision(1) << (totalSent ? 100.0 * totalReceived / totalSent : 0) << "%), "
+              << std::setprecision(3) << totalBytes * 8 / options.simTime / 1e3 << " kbps, "
+              << totalSyncLoss << " sync losses" << std::endl;
+}
+
+
+int main(int argc, char* argv[])
+{
+    SchedulerOptions options;
+    std::string mode = "all";
+    uint32_t bcnOrd = options.bcnOrd;
+    uint32_t sfrmOrd = options.sfrmOrd;
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("mode", "aligned, random, colored, all", mode);
+    cmd.AddValue("pans", "코디네이터(PAN) 수", options.panCount);
+    cmd.AddValue("devices", "PAN별 디바이스 수", options.devicesPerPan);
+    cmd.AddValue("panSpacing", "코디네이터 격자 간격 (m)", options.panSpacing);
+    cmd.AddValue("panRadius", "디바이스 배치 반경 (m)", options.panRadius);
+    cmd.AddValue("interferenceRange", "간섭 그래프 간선 기준 거리 (m)", options.interferenceRange);
+    cmd.AddValue("bo", "macBeaconOrder", bcnOrd);
+    cmd.AddValue("so", "macSuperframeOrder", sfrmOrd);
+    cmd.AddValue("interval", "디바이스별 전송 간격 (s)", options.interval);
+    cmd.AddValue("payload", "MSDU 크기 (byte)", options.payloadSize);
+    cmd.AddValue("simTime", "측정 시간 (s)", options.simTime);
+    cmd.Parse(argc, argv);
+
+    NS_ABORT_MSG_IF(bcnOrd > 14 || sfrmOrd > bcnOrd, "beacon-enabled PANs with SO <= BO <= 14 are required");
+    NS_ABORT_MSG_IF(mode != "aligned" && mode != "random" && mode != "colored" && mode != "all",
+                    "unknown mode: " << mode);
+    options.bcnOrd = bcnOrd;
+    options.sfrmOrd = sfrmOrd;
+
+    // 코디네이터를 정사각형 격자에 배치
+    uint32_t width = std::ceil(std::sqrt(options.panCount));
+    g_pans.assign(options.panCount, PanInfo());
+    for(uint32_t p = 0; p < options.panCount; p++)
+        g_pans[p].position = Vector((p % width) * options.panSpacing, (p / width) * options.panSpacing, 0);
+
+    // 간섭 그래프
+    std::vector<std::vector<uint32_t>> adjacency(options.panCount);
+    uint32_t edges = 0;
+    for(uint32_t a = 0; a < options.panCount; a++)
+    {
+        for(uint32_t b = a + 1; b < options.panCount; b++)
+        {
+            if(CalculateDistance(g_pans[a].position, g_pans[b].position) > options.interferenceRange)
+                continue;
+            adjacency[a].push_back(b);
+            adjacency[b].push_back(a);
+            edges++;
+        }
+    }
+
+    std::vector<uint32_t> colors = ColorGraph(adjacency);
+    uint32_t colorCount = *std::max_element(colors.begin(), colors.end()) + 1;
+    uint32_t slots = 1U << (options.bcnOrd - options.sfrmOrd);
+    Time sd = SuperframeDuration(options.sfrmOrd);
+
+    std::cout << options.panCount << " PANs, " << edges << " interference edges, "
+              << colorCount << " colors, " << slots << " superframe slots per beacon interval (SD "
+              << sd.As(Time::MS) << ", BI " << SuperframeDuration(options.bcnOrd).As(Time::MS) << ")" << std::endl;
+    if(colorCount > slots)
+    {
+        std::cout << "warning: " << colorCount << " colors do not fit in " << slots
+                  << " slots, slots are reused; increase BO or decrease SO" << std::endl;
+    }
+
+    if(mode == "aligned" || mode == "all")
+    {
+        for(PanInfo& pan : g_pans)
+        {
+            pan.color = 0;
+            pan.offset = Seconds(0);
+        }
+        Run(options);
+        PrintResult("aligned", options);
+    }
+
+    if(mode == "random" || mode == "all")
+    {
+        Ptr<UniformRandomVariable> random = CreateObject<UniformRandomVariable>();
+        for(PanInfo& pan : g_pans)
+        {
+            pan.color = random->GetInteger(0, slots - 1);
+            pan.offset = sd * pan.color;
+        }
+        Run(options);
+        PrintResult("random", options);
+    }
+
+    if(mode == "colored" || mode == "all")
+    {
+        for(uint32_t p = 0; p < g_pans.size(); p++)
+        {
+            g_pans[p].color = colors[p];
+            g_pans[p].offset = sd * (colors[p] % slots);
+        }
+        Run(options);
+        PrintResult("colored", options);
+    }
+
+    return 0;
+}
@@ -0,0 +1,736 @@
+/*
+ * 클러스터 트리(cluster-tree) 멀티홉 전달
+ *
+ * lr-wpan-superframe.cc와 같은 격자(가로 20개, 30 m 간격, 코디네이터는 원점)에서 코디네이터의
+ * 전파 범위를 벗어난 디바이스도 라우터를 거쳐 데이터를 보낼 수 있도록 트리를 구성합니다.
+ *
+ * 주소는 ZigBee 방식의 Cskip 블록으로 할당합니다.
+ *   Cm: 라우터 하나의 최대 자식 수, Rm: 그중 라우터 자식 수, Lm: 최대 깊이
+ *   Cskip(d) = 1 + Cm * (Lm - d - 1)                                   (Rm = 1)
+ *            = (1 + Cm - Rm - Cm * Rm^(Lm - d - 1)) / (1 - Rm)           (그 외)
+ *   깊이 d 라우터(주소 A)의 k번째 라우터 자식: A + 1 + k * Cskip(d)
+ *                       n번째 종단 자식    : A + Rm * Cskip(d) + n
+ * 라우터 A의 하위 트리는 주소 구간 (A, A + Cskip(d - 1))을 차지하므로, 목적지 주소만으로
+ * 자식 / 부모 중 다음 홉을 계산할 수 있고 목적지별 라우팅 테이블이 필요 없습니다.
+ *
+ * 트리는 시작 시 위치와 전파 범위(--range)로 구성합니다. 깊이 d 단계마다 깊이 d - 1 라우터의 범위 안에
+ * 있는 노드 중 코디네이터에서 먼 노드부터 라우터 자리를, 남은 노드는 가까운 순으로 종단 디바이스 자리를
+ * 받습니다. 자리를 받지 못한 노드는 다음 단계에서 더 깊은 라우터를 찾고, 끝내 받지 못하면 고아(orphan)로
+ * 남습니다. 모든 노드는 같은 PAN ID를 공유합니다.
+ *
+ * 비콘 모드(--bo < 15)에서는 코디네이터가 PAN 코디네이터로 MLME-START.request를 보내고, 라우터는 부모의
+ * 비콘을 추적(MLME-SYNC.request)한 뒤 PAN 코디네이터가 아닌 코디네이터로 자기 슈퍼프레임을 시작합니다.
+ * 라우터의 StartTime은 부모 비콘 기준 (1 + k) * SD(k: 부모의 k번째 라우터 자식)이므로, 부모 / 형제 라우터와
+ * 활성 구간이 겹치지 않습니다. 부모가 다른 라우터끼리는 슬롯이 겹칠 수 있습니다(슬롯 배정은
+ * lr-wpan-beacon-scheduler 참고). 라우터는 부모 방향 홉을 부모의 슈퍼프레임(들어오는 슈퍼프레임)에서,
+ * 자식 방향 홉을 자기 슈퍼프레임에서 보냅니다. 부모가 먼저 비콘을 내보내야 하므로 깊이마다 3 BI씩
+ * 늦게 시작하고, 모든 라우터가 시작한 뒤 트래픽을 보냅니다. --bo=15이면 비콘 없이 동작합니다.
+ *
+ * 트래픽
+ *  - 업링크: 모든 디바이스가 코디네이터(주소 0)에게 --interval마다 보냄
+ *  - 다운링크: 코디네이터가 --downInterval마다 참여한 디바이스에게 차례로 보냄, Cskip 규칙으로 자식 방향
+ *    다음 홉을 고르는 경로를 거칩니다.
+ * 각 홉은 TX_OPTION_ACK로 전달합니다. 격자 크기(--nodes 목록)별로 전달률, 깊이별 업링크 / 다운링크
+ * 전달률, 홉당 지연을 출력합니다.
+ *
+ * 사용 예:
+ *   ./ns3 run "lr-wpan-cluster-tree --nodes=100,400,1600,3200 --interval=60 --simTime=600 --bo=6 --so=2"
+ */
+#include <ns3/core-module.h>
+#include <ns3/lr-wpan-module.h>
+#include <ns3/simulator.h>
+
+#include <ns3/network-module.h>
+
+// channel
+#include <ns3/propagation-module.h>
+#include <ns3/spectrum-module.h>
+
+// mobility model
+#include <ns3/mobility-helper.h>
+#include <ns3/mobility-module.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+using namespace ns3;
+
+const int COORDINATOR_PAN_ID = 5;
+const int COORDINATOR_CHANNEL = 11;
+
+/// aBaseSuperframeDuration (심볼), 2.4 GHz O-QPSK 심볼 길이 (us)
+const uint32_t BASE_SUPERFRAME_DURATION = 960;
+const uint32_t SYMBOL_DURATION_US = 16;
+
+/// 페이로드: [출발 주소 2][목적지 주소 2][seq 4][생성 시각 ns 8][홉 시작 시각 ns 8][홉 수 1]
+const uint32_t TREE_HEADER_SIZE = 25;
+
+
+/// @brief Cskip 주소 할당 파라미터
+struct TreeParams
+{
+    uint32_t cm = 6;    ///< 최대 자식 수
+    uint32_t rm = 2;    ///< 최대 라우터 자식 수
+    uint32_t lm = 13;   ///< 최대 깊이
+
+    /// @brief 깊이 depth 라우터의 자식 라우터 하나가 차지하는 주소 블록 크기
+    uint32_t Cskip(uint32_t depth) const
+    {
+        if(depth >= lm)
+            return 0;
+        if(rm == 1)
+            return 1 + cm * (lm - depth - 1);
+        int64_t power = static_cast<int64_t>(std::pow(rm, lm - depth - 1));
+        return (1 + int64_t(cm) - int64_t(rm) - int64_t(cm) * power) / (1 - int64_t(rm));
+    }
+
+    /// @brief 트리 전체가 사용하는 주소 수 (코디네이터 포함)
+    uint64_t AddressSpace() const
+    {
+        return 1 + static_cast<uint64_t>(rm) * Cskip(0) + (cm - rm);
+    }
+};
+
+
+/// @brief 트리 노드 하나의 상태
+struct TreeNode
+{
+    Ptr<LrWpanMac> mac;
+    Vector position;
+    bool joined = false;
+    bool router = false;
+    uint32_t depth = 0;
+    uint16_t address = 0;
+    uint16_t parentAddress = 0;
+    uint32_t childIndex = 0;        ///< 라우터면 부모의 몇 번째 라우터 자식인지
+    uint32_t routerChildren = 0;
+    uint32_t endChildren = 0;
+    uint32_t seq = 0;
+};
+
+
+/// @brief 깊이별 통계
+struct DepthStats
+{
+    uint32_t nodes = 0;
+    uint64_t generated = 0;     ///< 이 깊이에서 출발한 프레임
+    uint64_t delivered = 0;     ///< 그중 코디네이터에 도착한 프레임
+    Time endToEndSum;
+    uint64_t downGenerated = 0; ///< 이 깊이로 가는 다운링크 프레임
+    uint64_t downDelivered = 0; ///< 그중 목적지에 도착한 프레임
+    Time downEndToEndSum;
+    uint64_t hops = 0;          ///< 이 깊이의 노드가 보낸 홉 수 (부모 / 자식 방향 모두)
+    Time hopSum;
+};
+
+
+/// @brief 실행 결과
+struct TreeResult
+{
+    uint32_t nodeCount = 0;
+    uint32_t joined = 0;
+    uint32_t routers = 0;
+    uint64_t forwardFailures = 0;   ///< 홉 전송 실패 (MCPS-DATA.confirm 실패)
+    uint32_t startFailures = 0;     ///< 실패한 MLME-START.request
+    uint32_t syncLosses = 0;        ///< MLME-SYNC-LOSS.indication
+    std::vector<DepthStats> depths;
+};
+
+
+/// @brief 슈퍼프레임 설정
+struct SuperframeParams
+{
+    uint32_t bcnOrd = 6;    ///< BO, 15이면 비콘 미사용
+    uint32_t sfrmOrd = 2;   ///< SO
+
+    bool BeaconEnabled() const
+    {
+        return bcnOrd < 15;
+    }
+
+    /// @brief SD (심볼)
+    uint32_t SuperframeSymbols() const
+    {
+        return BASE_SUPERFRAME_DURATION << sfrmOrd;
+    }
+
+    /// @brief BI
+    Time BeaconInterval() const
+    {
+        return MicroSeconds(static_cast<uint64_t>(SYMBOL_DURATION_US) * (BASE_SUPERFRAME_DURATION << bcnOrd));
+    }
+};
+
+
+static TreeParams g_params;
+static SuperframeParams g_superframe;
+static TreeResult g_result;
+static std::vector<TreeNode> g_nodes;
+static std::vector<uint32_t> g_downlinkTargets;     ///< 다운링크 목적지 (참여한 디바이스 인덱스)
+
+
+static uint16_t
+ToUint16(Mac16Address address)
+{
+    uint8_t buffer[2];
+    address.CopyTo(buffer);
+    return (buffer[0] << 8) | buffer[1];
+}
+
+
+static void
+WriteUint(uint8_t* p, uint64_t value, uint32_t bytes)
+{
+    for(uint32_t i = 0; i < bytes; i++)
+        p[i] = value >> (8 * (bytes - i - 1));
+}
+
+
+static uint64_t
+ReadUint(const uint8_t* p, uint32_t bytes)
+{
+    uint64_t value = 0;
+    for(uint32_t i = 0; i < bytes; i++)
+        value = (value << 8) | p[i];
+    return value;
+}
+
+
+/// @brief Cskip 규칙으로 다음 홉 주소를 계산합니다. 라우팅 테이블 없이 주소만 사용합니다.
+/// @param node 현재 노드
+/// @param dst 최종 목적지 주소
+/// @return 다음 홉 주소
+static uint16_t
+NextHop(const TreeNode& node, uint16_t dst)
+{
+    uint32_t a = node.address;
+
+    // 목적지가 자신의 하위 트리에 있는지 확인, 코디네이터는 모든 주소를 포함
+    bool descendant = dst > a && (node.depth == 0 || dst < a + g_params.Cskip(node.depth - 1));
+    if(!descendant)
+        return node.parentAddress;
+
+    uint32_t cskip = g_params.Cskip(node.depth);
+    if(dst > a + g_params.rm * cskip)
+        return dst;     // 종단 자식
+    return a + 1 + ((dst - (a + 1)) / cskip) * cskip;
+}
+
+
+/// @brief 트리 프레임을 다음 홉으로 보냅니다.
+static void
+SendHop(TreeNode& node, uint8_t* frame)
+{
+    static uint8_t msduHandle = 0;
+
+    uint16_t dst = ReadUint(frame + 2, 2);
+    WriteUint(frame + 16, Simulator::Now().GetNanoSeconds(), 8);
+
+    McpsDataRequestParams params;
+    params.m_dstPanId = COORDINATOR_PAN_ID;
+    params.m_srcAddrMode = SHORT_ADDR;
+    params.m_dstAddrMode = SHORT_ADDR;
+    params.m_dstAddr = Mac16Address(NextHop(node, dst));
+    params.m_msduHandle = msduHandle++;
+    params.m_txOptions = TX_OPTION_ACK;
+
+    node.mac->McpsDataRequest(params, Create<Packet>(frame, TREE_HEADER_SIZE));
+}
+
+
+/// @brief 새 트리 프레임을 만들어 첫 홉으로 보냅니다.
+/// @param node 출발 노드
+/// @param dst 최종 목적지 주소
+static void
+Originate(TreeNode& node, uint16_t dst)
+{
+    uint8_t frame[TREE_HEADER_SIZE] = {};
+    WriteUint(frame, node.address, 2);
+    WriteUint(frame + 2, dst, 2);
+    WriteUint(frame + 4, node.seq++, 4);
+    WriteUint(frame + 8, Simulator::Now().GetNanoSeconds(), 8);
+    SendHop(node, frame);
+}
+
+
+/// @brief 코디네이터에게 보낼 데이터를 주기적으로 생성합니다.
+static void
+Generate(uint32_t index, Time interval)
+{
+    TreeNode& node = g_nodes[index];
+
+    Originate(node, 0);
+    g_result.depths[node.depth].generated++;
+
+    Simulator::Schedule(interval, &Generate, index, interval);
+}
+
+
+/// @brief 코디네이터가 참여한 디바이스에게 차례로 다운링크 데이터를 보냅니다.
+/// @param next g_downlinkTargets에서 이번에 보낼 목적지 위치
+static void
+GenerateDownlink(uint32_t next, Time interval)
+{
+    const TreeNode& target = g_nodes[g_downlinkTargets[next]];
+
+    Originate(g_nodes[0], target.address);
+    g_result.depths[target.depth].downGenerated++;
+
+    Simulator::Schedule(interval, &GenerateDownlink, (next + 1) % g_downlinkTargets.size(), interval);
+}
+
+
+/// @brief MCPS-DATA.indication 콜백: 목적지면 수신 처리, 아니면 다음 홉으로 전달
+static void
+TreeDataIndication(uint32_t index, McpsDataIndicationParams params, Ptr<Packet> p)
+{
+    uint8_t frame[TREE_HEADER_SIZE];
+    if(p->CopyData(frame, TREE_HEADER_SIZE) < TREE_HEADER_SIZE)
+        return;
+
+    TreeNode& node = g_nodes[index];
+    Time hopStart = NanoSeconds(ReadUint(frame + 16, 8));
+
+    // 홉 지연은 보낸 노드의 깊이에 누적 (부모로 올라가는 홉이면 node.depth + 1)
+    uint16_t src = ToUint16(params.m_srcAddr);
+    uint32_t senderDepth = src == node.parentAddress && node.depth > 0 ? node.depth - 1 : node.depth + 1;
+    if(senderDepth < g_result.depths.size())
+    {
+        g_result.depths[senderDepth].hops++;
+        g_result.depths[senderDepth].hopSum += Simulator::Now() - hopStart;
+    }
+
+    frame[24]++;
+    uint16_t dst = ReadUint(frame + 2, 2);
+    if(dst != node.address)
+    {
+        SendHop(node, frame);
+        return;
+    }
+
+    Time endToEnd = Simulator::Now() - NanoSeconds(ReadUint(frame + 8, 8));
+    if(ReadUint(frame, 2) == 0)
+    {
+        // 다운링크는 목적지 깊이로 누적
+        g_result.depths[node.depth].downDelivered++;
+        g_result.depths[node.depth].downEndToEndSum += endToEnd;
+        return;
+    }
+
+    // 업링크의 출발 깊이는 홉 수와 같음
+    uint32_t originDepth = frame[24];
+    if(originDepth < g_result.depths.size())
+    {
+        g_result.depths[originDepth].delivered++;
+        g_result.depths[originDepth].endToEndSum += endToEnd;
+    }
+}
+
+
+static void
+TreeDataConfirm(McpsDataConfirmParams params)
+{
+    if(params.m_status != IEEE_802_15_4_SUCCESS)
+        g_result.forwardFailures++;
+}
+
+
+static void
+MlmeStartConfirm(MlmeStartConfirmParams params)
+{
+    if(params.m_status != MLMESTART_SUCCESS)
+        g_result.startFailures++;
+}
+
+
+static void
+MlmeSyncLossIndication(MlmeSyncLossIndicationParams params)
+{
+    g_result.syncLosses++;
+}
+
+
+/// @brief 비콘 모드에서 각 노드가 부모의 비콘을 추적하고, 라우터는 자기 슈퍼프레임을 시작하도록 예약합니다.
+/// @param nodes g_nodes와 같은 순서의 노드
+/// @param base 코디네이터가 시작하는 시각
+/// @param step 깊이 하나당 시작 간격
+static void
+ScheduleSuperframes(const NodeContainer& nodes, Time base, Time step)
+{
+    for(uint32_t i = 0; i < g_nodes.size(); i++)
+    {
+        TreeNode& node = g_nodes[i];
+        if(!node.joined)
+            continue;
+
+        uint32_t context = nodes.Get(i)->GetId();
+        node.mac->SetMlmeStartConfirmCallback(MakeCallback(&MlmeStartConfirm));
+
+        if(i > 0)
+        {
+            // 부모가 슈퍼프레임을 시작할 때 비콘 추적을 시작
+            node.mac->SetAssociatedCoor(Mac16Address(node.parentAddress));
+            node.mac->SetMlmeSyncLossIndicationCallback(MakeCallback(&MlmeSyncLossIndication));
+
+            MlmeSyncRequestParams syncParams;
+            syncParams.m_logCh = COORDINATOR_CHANNEL;
+            syncParams.m_trackBcn = true;
+            Simulator::ScheduleWithContext(context,
+                                           base + step * (node.depth - 1),
+                                           &LrWpanMac::MlmeSyncRequest,
+                                           node.mac,
+                                           syncParams);
+        }
+
+        if(!node.router)
+            continue;
+
+        MlmeStartRequestParams startParams;
+        startParams.m_PanId = COORDINATOR_PAN_ID;
+        startParams.m_logCh = COORDINATOR_CHANNEL;
+        startParams.m_bcnOrd = g_superframe.bcnOrd;
+        startParams.m_sfrmOrd = g_superframe.sfrmOrd;
+        startParams.m_coorRealgn = false;
+        startParams.m_panCoor = i == 0;
+        // 부모의 활성 구간 뒤, 형제 라우터끼리는 다른 SD 슬롯
+        startParams.m_StartTime = i == 0 ? 0 : (1 + node.childIndex) * g_superframe.SuperframeSymbols();
+        Simulator::ScheduleWithContext(context,
+                                       base + step * node.depth,
+                                       &LrWpanMac::MlmeStartRequest,
+                                       node.mac,
+                                       startParams);
+    }
+}
+
+
+/// @brief 위치와 전파 범위로 트리를 구성하고 Cskip 주소를 할당합니다. 0번 노드가 코디네이터입니다.
+/// @param range 링크로 인정하는 최대 거리 (m)
+static void
+BuildTree(double range)
+{
+    TreeNode& root = g_nodes[0];
+    root.joined = true;
+    root.router = true;
+    root.depth = 0;
+    root.address = 0;
+
+    auto distance = [](const TreeNode& a, const TreeNode& b) {
+        return CalculateDistance(a.position, b.position);
+    };
+
+    for(uint32_t depth = 1; depth <= g_params.lm; depth++)
+    {
+        // 이 단계에서 부모가 될 수 있는 라우터와 그 범위 안의 후보
+        std::vector<uint32_t> parents;
+        for(uint32_t i = 0; i < g_nodes.size(); i++)
+            if(g_nodes[i].joined && g_nodes[i].router && g_nodes[i].depth == depth - 1)
+                parents.push_back(i);
+
+        std::vector<uint32_t> candidates;
+        for(uint32_t i = 0; i < g_nodes.size(); i++)
+        {
+            if(g_nodes[i].joined)
+                continue;
+            for(uint32_t parent : parents)
+            {
+                if(distance(g_nodes[i], g_nodes[parent]) <= range)
+                {
+                    candidates.push_back(i);
+                    break;
+                }
+            }
+        }
+        if(candidates.empty())
+            break;
+
+        // 가장 가까운, 자리가 남은 부모를 찾음
+        auto findParent = [&](uint32_t i, bool asRouter) -> int64_t {
+            int64_t best = -1;
+            double bestDistance = range;
+            for(uint32_t parent : parents)
+            {
+                const TreeNode& p = g_nodes[parent];
+                bool hasSlot = asRouter ? p.routerChildren < g_params.rm
+                                        : p.endChildren < g_params.cm - g_params.rm;
+                double d = distance(g_nodes[i], p);
+                if(hasSlot && d <= bestDistance)
+                {
+                    best = parent;
+                    bestDistance = d;
+                }
+            }
+            return best;
+        };
+
+        auto join = [&](uint32_t i, uint32_t parentIndex, bool asRouter) {
+            TreeNode& p = g_nodes[parentIndex];
+            TreeNode& node = g_nodes[i];
+            uint32_t cskip = g_params.Cskip(p.depth);
+            node.joined = true;
+            node.router = asRouter;
+            node.depth = depth;
+            node.parentAddress = p.address;
+            node.childIndex = asRouter ? p.routerChildren : 0;
+            node.address = asRouter ? p.address + 1 + p.routerChildren++ * cskip
+                                    : p.address + g_params.rm * cskip + ++p.endChildren;
+        };
+
+        // 트리를 넓히도록 코디네이터에서 먼 후보부터 라우터 자리를 줌 (최대 깊이에서는 라우터 불가)
+        std::sort(candidates.begin(), candidates.end(), [&](uint32_t a, uint32_t b) {
+            return distance(g_nodes[a], root) > distance(g_nodes[b], root);
+        });
+        if(depth < g_params.lm)
+        {
+            for(uint32_t i : candidates)
+            {
+                int64_t parent = findParent(i, true);
+                if(parent >= 0)
+                    join(i, parent, true);
+            }
+        }
+
+        // 남은 후보는 가까운 순으로 종단 디바이스 자리를 받음
+        for(auto it = candidates.rbegin(); it != candidates.rend(); it++)
+        {
+            if(g_nodes[*it].joined)
+                continue;
+            int64_t parent = findParent(*it, false);
+            if(parent >= 0)
+                join(*it, parent, false);
+        }
+    }
+}
+
+
+/// @brief 격자 하나에 대해 트리를 구성하고 실행합니다.
+/// @param deviceCount 코디네이터를 제외한 디바이스 수
+static TreeResult
+RunTree(uint32_t deviceCount,
+        uint32_t gridWidth,
+        double spacing,
+        double range,
+        Time interval,
+        Time downInterval,
+        Time simTime)
+{
+    g_result = TreeResult();
+    g_result.nodeCount = deviceCount;
+    g_result.depths.resize(g_params.lm + 1);
+    g_nodes.assign(deviceCount + 1, TreeNode());
+    RngSeedManager::SetSeed(1);
+    RngSeedManager::SetRun(1);
+
+    Ptr<Node> coordinator = CreateObject<Node>();
+    NodeContainer devices;
+    devices.Create(deviceCount);
+    NodeContainer nodes(coordinator);
+    nodes.Add(devices);
+
+    MobilityHelper mobilityHelper;
+    mobilityHelper.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+    mobilityHelper.Install(coordinator);
+    mobilityHelper.SetPositionAllocator("ns3::GridPositionAllocator",
+                                        "MinX", DoubleValue(-spacing),
+                                        "MinY", DoubleValue(-spacing),
+                                        "DeltaX", DoubleValue(spacing),
+                                        "DeltaY", DoubleValue(spacing),
+                                        "GridWidth", UintegerValue(gridWidth),
+                                        "LayoutType", StringValue("RowFirst"));
+    mobilityHelper.Install(devices);
+    coordinator->GetObject<MobilityModel>()->SetPosition(Vector(0, 0, 0));
+
+    // 수천 노드에서도 전송마다 모든 수신기를 거치지 않도록 MaxLossDb 설정 (lr-wpan-grid-bench 참고)
+    Ptr<SingleModelSpectrumChannel> channel = CreateObject<SingleModelSpectrumChannel>();
+    channel->AddPropagationLossModel(CreateObject<LogDistancePropagationLossModel>());
+    channel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
+    channel->SetAttribute("MaxLossDb", DoubleValue(115));
+
+    LrWpanHelper lrWpanHelper;
+    lrWpanHelper.SetChannel(channel);
+    NetDeviceContainer netDevices = lrWpanHelper.Install(nodes);
+
+    for(uint32_t i = 0; i < nodes.GetN(); i++)
+    {
+        g_nodes[i].mac = DynamicCast<LrWpanNetDevice>(netDevices.Get(i))->GetMac();
+        g_nodes[i].position = nodes.Get(i)->GetObject<MobilityModel>()->GetPosition();
+    }
+
+    BuildTree(range);
+
+    uint32_t maxDepth = 0;
+    for(const TreeNode& node : g_nodes)
+        if(node.joined)
+            maxDepth = std::max(maxDepth, node.depth);
+
+    // 비콘 모드에서는 가장 깊은 라우터까지 슈퍼프레임을 시작한 뒤 트래픽을 보냄
+    Time warmup = Seconds(1);
+    if(g_superframe.BeaconEnabled())
+    {
+        Time step = g_superframe.BeaconInterval() * 3;
+        ScheduleSuperframes(nodes, Seconds(0.5), step);
+        warmup = Seconds(0.5) + step * (maxDepth + 1);
+    }
+
+    Ptr<UniformRandomVariable> jitter = CreateObject<UniformRandomVariable>();
+    for(uint32_t i = 0; i < g_nodes.size(); i++)
+    {
+        TreeNode& node = g_nodes[i];
+        if(!node.joined)
+            continue;
+
+        g_result.joined++;
+        g_result.routers += node.router;
+        g_result.depths[node.depth].nodes++;
+
+        node.mac->SetPanId(COORDINATOR_PAN_ID);
+        node.mac->SetShortAddress(Mac16Address(node.address));
+        node.mac->SetMcpsDataIndicationCallback(MakeBoundCallback(&TreeDataIndication, i));
+        node.mac->SetMcpsDataConfirmCallback(MakeCallback(&TreeDataConfirm));
+
+        if(i == 0)
+            continue;
+        g_downlinkTargets.push_back(i);
+        Simulator::ScheduleWithContext(nodes.Get(i)->GetId(),
+                                       warmup + Seconds(jitter->GetValue(0, interval.GetSeconds())),
+                                       &Generate,
+                                       i,
+                                       interval);
+    }
+    g_result.joined--;      // 코디네이터 제외
+
+    // 다운링크는 깊은 노드부터 보내 자식 방향 경로가 짧은 실행에서도 쓰이도록 함
+    std::stable_sort(g_downlinkTargets.begin(), g_downlinkTargets.end(), [](uint32_t a, uint32_t b) {
+        return g_nodes[a].depth > g_nodes[b].depth;
+    });
+    if(!g_downlinkTargets.empty() && downInterval.IsStrictlyPositive())
+    {
+        Simulator::ScheduleWithContext(nodes.Get(0)->GetId(),
+                                       warmup + Seconds(jitter->GetValue(0, downInterval.GetSeconds())),
+                                       &GenerateDownlink,
+                                       0,
+                                       downInterval);
+    }
+
+    Simulator::Stop(warmup + simTime);
+    Simulator::Run();
+    Simulator::Destroy();
+    g_nodes.clear();
+    g_downlinkTargets.clear();
+
+    return g_result;
+}
+
+
+int main(int argc, char* argv[])
+{
+    std::string nodeList = "100,400,1600";
+    uint32_t gridWidth = 20;
+    double spacing = 30;
+    double range = 45;
+    double interval = 60;
+    double downInterval = 1;
+    double simTime = 600;
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("nodes", "쉼표로 구분한 디바이스 수 목록", nodeList);
+    cmd.AddValue("gridWidth", "격자 가로 노드 수, 0이면 정사각형", gridWidth);
+    cmd.AddValue("spacing", "격자 간격 (m)", spacing);
+    cmd.AddValue("range", "트리 구성 시 링크로 인정하는 최대 거리 (m)", range);
+    cmd.AddValue("cm", "Cskip Cm: 최대 자식 수", g_params.cm);
+    cmd.AddValue("rm", "Cskip Rm: 최대 라우터 자식 수", g_params.rm);
+    cmd.AddValue("lm", "Cskip Lm: 최대 깊이", g_params.lm);
+    cmd.AddValue("interval", "디바이스별 업링크 전송 간격 (s)", interval);
+    cmd.AddValue("downInterval", "코디네이터의 다운링크 전송 간격 (s), 0이면 보내지 않음", downInterval);
+    cmd.AddValue("bo", "Beacon Order, 15이면 비콘 미사용", g_superframe.bcnOrd);
+    cmd.AddValue("so", "Superframe Order", g_superframe.sfrmOrd);
+    cmd.AddValue("simTime", "시뮬레이션 시간 (s)", simTime);
+    cmd.Parse(argc, argv);
+
+    NS_ABORT_MSG_IF(g_params.rm == 0 || g_params.rm > g_params.cm, "0 < rm <= cm is required");
+    NS_ABORT_MSG_IF(g_params.AddressSpace() > 0xFFFD,
+                    "Cskip parameters need " << g_params.AddressSpace() << " addresses, more than 16-bit short addresses allow");
+    NS_ABORT_MSG_IF(g_superframe.bcnOrd > 15 || g_superframe.sfrmOrd > g_superframe.bcnOrd,
+                    "0 <= so <= bo <= 15 is required");
+    // 라우터 자식은 부모 비콘 뒤 1 .. rm번째 SD 슬롯을 쓰므로 BI 안에 rm + 1개 슬롯이 필요
+    NS_ABORT_MSG_IF(g_superframe.BeaconEnabled() && (1u << (g_superframe.bcnOrd - g_superframe.sfrmOrd)) < g_params.rm + 1,
+                    "2^(bo - so) must be at least rm + 1 so that router superframes do not overlap their parent's");
+
+    std::cout << "Cskip(0) = " << g_params.Cskip(0) << ", address space " << g_params.AddressSpace() << std::endl;
+
+    std::stringstream ss(nodeList);
+    std::string item;
+    while(std::getline(ss, item, ','))
+    {
+        uint32_t deviceCount = std::stoul(item);
+        uint32_t width = gridWidth ? gridWidth : std::ceil(std::sqrt(deviceCount));
+        TreeResult result =
+            RunTree(deviceCount, width, spacing, range, Seconds(interval), Seconds(downInterval), Seconds(simTime));
+
+        uint64_t generated = 0;
+        uint64_t delivered = 0;
+        uint64_t downGenerated = 0;
+        uint64_t downDelivered = 0;
+        for(const DepthStats& stats : result.depths)
+        {
+            generated += stats.generated;
+            delivered += stats.delivered;
+            downGenerated += stats.downGenerated;
+            downDelivered += stats.downDelivered;
+        }
+
+        std::cout
+            << std::endl
+            << std::fixed << std::setprecision(3)
+            << result.nodeCount << " devices: joined " << result.joined
+            << " (" << 100.0 * result.joined / result.nodeCount << "%)"
+            << ", routers " << result.routers
+            << ", orphans " << result.nodeCount - result.joined
+            << ", uplink delivery " << (generated ? 100.0 * delivered / generated : 0) << "%"
+            << ", downlink delivery " << (downGenerated ? 100.0 * downDelivered / downGenerated : 0) << "%"
+            << ", hop failures " << result.forwardFailures
+            << ", start failures " << result.startFailures
+            << ", sync losses " << result.syncLosses
+            << std::endl
+            << std::right
+            << std::setw(7) << "depth"
+            << std::setw(8) << "nodes"
+            << std::setw(12) << "generated"
+            << std::setw(12) << "delivered"
+            << std::setw(10) << "ratio%"
+            << std::setw(14) << "e2e(ms)"
+            << std::setw(12) << "down gen"
+            << std::setw(12) << "down dlv"
+            << std::setw(10) << "down%"
+            << std::setw(14) << "down e2e(ms)"
+            << std::setw(14) << "hop(ms)"
+            << std::endl
+        ;
+
+        for(uint32_t depth = 0; depth < result.depths.size(); depth++)
+        {
+            const DepthStats& stats = result.depths[depth];
+            if(stats.nodes == 0)
+                continue;
+            std::cout
+                << std::setw(7) << depth
+                << std::setw(8) << stats.nodes
+                << std::setw(12) << stats.generated
+                << std::setw(12) << stats.delivered
+                << std::setw(10) << (stats.generated ? 100.0 * stats.delivered / stats.generated : 0)
+                << std::setw(14) << (stats.delivered ? stats.endToEndSum.GetSeconds() * 1e3 / stats.delivered : 0)
+                << std::setw(12) << stats.downGenerated
+                << std::setw(12) << stats.downDelivered
+                << std::setw(10) << (stats.downGenerated ? 100.0 * stats.downDelivered / stats.downGenerated : 0)
+                << std::setw(14) << (stats.downDelivered ? stats.downEndToEndSum.GetSeconds() * 1e3 / stats.downDelivered : 0)
+                << std::setw(14) << (stats.hops ? stats.hopSum.GetSeconds() * 1e3 / stats.hops : 0)
+                << std::endl
+            ;
+        }
+    }
+
+    return 0;
+}
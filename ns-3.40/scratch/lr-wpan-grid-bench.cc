@@ -0,0 +1,223 @@
+/*
+ * 밀집 격자 시나리오의 프레임당 CPU 시간 측정
+ *
+ * lr-wpan-superframe.cc와 같은 격자(가로 20개, 30 m 간격)에 디바이스를 배치하고 모든 디바이스가
+ * 오른쪽 이웃에게 주기적으로 데이터를 보냅니다. SingleModelSpectrumChannel은 전송마다 모든 수신기에
+ * 대해 PSD를 복사하고 빈(bin)마다 경로 이득을 곱한 뒤 LrWpanPhy::StartRx()를 호출합니다.
+ * 멀리 떨어진 수신기에서는 이 신호가 잡음보다 훨씬 작습니다.
+ *
+ * SpectrumChannel의 MaxLossDb 속성을 설정하면 경로 손실이 그보다 큰 수신기로는 PSD를 만들지도
+ * 전달하지도 않으므로, 2.4 GHz O-QPSK 신호 하나가 거치는 PSD 연산 수가 전파 범위 안의 노드 수로
+ * 줄어듭니다. 잘라낸 신호는 간섭 합계에서도 빠지므로, 약한 송신이 많이 겹치면 SINR이 조금 달라집니다.
+ * 이 차이가 무시할 만한지는 전달 결과로 확인합니다. 같은 시나리오를 MaxLossDb 없이 / 있이 실행해
+ * wall-clock 시간과 전달된 프레임 수를 비교하고, 차이가 있으면 그 크기를 출력합니다.
+ *
+ * 기본 임계값 115 dB: 송신 전력 0 dBm 기준으로 잡음 바닥(약 -101 dBm)보다 14 dB 이상 약한
+ * 신호만 잘라냅니다.
+ *
+ * 사용 예:
+ *   ./ns3 run "lr-wpan-grid-bench --nodes=400 --simTime=20 --maxLossDb=115"
+ */
+#include <ns3/core-module.h>
+#include <ns3/lr-wpan-module.h>
+#include <ns3/simulator.h>
+
+#include <ns3/network-module.h>
+
+// channel
+#include <ns3/propagation-module.h>
+#include <ns3/spectrum-module.h>
+
+// mobility model
+#include <ns3/mobility-helper.h>
+#include <ns3/mobility-module.h>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+using namespace ns3;
+
+const int COORDINATOR_PAN_ID = 5;
+
+
+/// @brief 실행 한 번의 측정 결과
+struct BenchResult
+{
+    uint64_t txFrames = 0;
+    uint64_t rxBegin = 0;       ///< PHY가 수신을 시작한(동기화한) 프레임 수
+    uint64_t delivered = 0;     ///< MCPS-DATA.indication 수
+    double wallSeconds = 0;
+};
+
+static BenchResult g_result;
+
+
+static void
+PhyTxBegin(Ptr<const Packet> p)
+{
+    g_result.txFrames++;
+}
+
+
+static void
+PhyRxBegin(Ptr<const Packet> p)
+{
+    g_result.rxBegin++;
+}
+
+
+static void
+McpsDataIndication(McpsDataIndicationParams params, Ptr<Packet> p)
+{
+    g_result.delivered++;
+}
+
+
+/// @brief 오른쪽 이웃에게 주기적으로 데이터를 보냅니다.
+/// @param mac Ptr<LrWpanMac>
+/// @param dst 이웃의 짧은 주소
+/// @param interval 전송 간격
+static void
+SendData(Ptr<LrWpanMac> mac, Mac16Address dst, Time interval)
+{
+    static uint8_t msduHandle = 0;
+
+    McpsDataRequestParams params;
+    params.m_dstPanId = COORDINATOR_PAN_ID;
+    params.m_srcAddrMode = SHORT_ADDR;
+    params.m_dstAddrMode = SHORT_ADDR;
+    params.m_dstAddr = dst;
+    params.m_msduHandle = msduHandle++;
+    params.m_txOptions = TX_OPTION_NONE;
+
+    mac->McpsDataRequest(params, Create<Packet>(20));
+
+    Simulator::Schedule(interval, &SendData, mac, dst, interval);
+}
+
+
+/// @brief 격자 시나리오를 한 번 실행합니다.
+/// @param nodeCount 디바이스 수
+/// @param maxLossDb SpectrumChannel MaxLossDb, 0 이하이면 설정하지 않음
+/// @param interval 디바이스별 전송 간격
+/// @param simTime 시뮬레이션 시간
+/// @return 측정 결과
+static BenchResult
+RunGrid(uint32_t nodeCount, double maxLossDb, Time interval, Time simTime)
+{
+    g_result = BenchResult();
+    RngSeedManager::SetSeed(1);
+    RngSeedManager::SetRun(1);
+
+    const uint32_t gridWidth = 20;
+
+    NodeContainer nodes;
+    nodes.Create(nodeCount);
+
+    MobilityHelper mobilityHelper;
+    mobilityHelper.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+    mobilityHelper.SetPositionAllocator("ns3::GridPositionAllocator",
+                                        "MinX", DoubleValue(-30.0),
+                                        "MinY", DoubleValue(-30.0),
+                                        "DeltaX", DoubleValue(30.0),
+                                        "DeltaY", DoubleValue(30.0),
+                                        "GridWidth", UintegerValue(gridWidth),
+                                        "LayoutType", StringValue("RowFirst"));
+    mobilityHelper.Install(nodes);
+
+    Ptr<SingleModelSpectrumChannel> channel = CreateObject<SingleModelSpectrumChannel>();
+    channel->AddPropagationLossModel(CreateObject<LogDistancePropagationLossModel>());
+    channel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
+    if(maxLossDb > 0)
+        channel->SetAttribute("MaxLossDb", DoubleValue(maxLossDb));
+
+    LrWpanHelper lrWpanHelper;
+    lrWpanHelper.SetChannel(channel);
+    NetDeviceContainer netDevices = lrWpanHelper.Install(nodes);
+    lrWpanHelper.CreateAssociatedPan(netDevices, COORDINATOR_PAN_ID);
+
+    Ptr<UniformRandomVariable> jitter = CreateObject<UniformRandomVariable>();
+    for(uint32_t i = 0; i < netDevices.GetN(); i++)
+    {
+        Ptr<LrWpanNetDevice> netDevice = DynamicCast<LrWpanNetDevice>(netDevices.Get(i));
+        netDevice->GetPhy()->TraceConnectWithoutContext("PhyTxBegin", MakeCallback(&PhyTxBegin));
+        netDevice->GetPhy()->TraceConnectWithoutContext("PhyRxBegin", MakeCallback(&PhyRxBegin));
+        netDevice->GetMac()->SetMcpsDataIndicationCallback(MakeCallback(&McpsDataIndication));
+
+        // 행의 마지막 디바이스는 왼쪽 이웃에게 보냄
+        uint32_t neighbour = (i % gridWidth == gridWidth - 1 || i + 1 == netDevices.GetN()) ? i - 1 : i + 1;
+        Mac16Address dst = DynamicCast<LrWpanNetDevice>(netDevices.Get(neighbour))->GetMac()->GetShortAddress();
+
+        Simulator::ScheduleWithContext(nodes.Get(i)->GetId(),
+                                       Seconds(jitter->GetValue(0, interval.GetSeconds())),
+                                       &SendData,
+                                       netDevice->GetMac(),
+                                       dst,
+                                       interval);
+    }
+
+    Simulator::Stop(simTime);
+
+    auto wallStart = std::chrono::steady_clock::now();
+    Simulator::Run();
+    g_result.wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+
+    Simulator::Destroy();
+    return g_result;
+}
+
+
+int main(int argc, char* argv[])
+{
+    uint32_t nodeCount = 400;
+    double maxLossDb = 115;
+    double interval = 1.0;
+    double simTime = 20;
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("nodes", "디바이스 수 (가로 20개 격자)", nodeCount);
+    cmd.AddValue("maxLossDb", "SpectrumChannel MaxLossDb (dB)", maxLossDb);
+    cmd.AddValue("interval", "디바이스별 전송 간격 (s)", interval);
+    cmd.AddValue("simTime", "시뮬레이션 시간 (s)", simTime);
+    cmd.Parse(argc, argv);
+
+    NS_ABORT_MSG_IF(nodeCount < 2, "at least two nodes are required");
+
+    BenchResult full = RunGrid(nodeCount, 0, Seconds(interval), Seconds(simTime));
+    BenchResult pruned = RunGrid(nodeCount, maxLossDb, Seconds(interval), Seconds(simTime));
+
+    auto print = [](const std::string& title, const BenchResult& result) {
+        std::cout
+            << std::left << std::setw(24) << title
+            << std::fixed << std::setprecision(3)
+            << "tx " << result.txFrames
+            << ", rx begin " << result.rxBegin
+            << ", delivered " << result.delivered
+            << ", wall " << result.wallSeconds << " s"
+            << ", " << (result.txFrames ? result.wallSeconds * 1e6 / result.txFrames : 0) << " us/frame"
+            << std::endl
+        ;
+    };
+
+    print("all receivers", full);
+    print("MaxLossDb " + std::to_string(static_cast<int>(maxLossDb)) + " dB", pruned);
+
+    // 잘라낸 신호가 빠진 간섭 합계 때문에 달라진 전달 결과
+    int64_t deliveredDiff = static_cast<int64_t>(pruned.delivered) - static_cast<int64_t>(full.delivered);
+    std::cout << "delivered difference: " << std::showpos << deliveredDiff << std::noshowpos;
+    if(full.delivered > 0)
+        std::cout << " (" << std::setprecision(3) << 100.0 * deliveredDiff / full.delivered << "%)";
+    std::cout << std::endl;
+
+    if(pruned.wallSeconds > 0)
+    {
+        std::cout << "per-frame CPU reduction: "
+                  << std::setprecision(1)
+                  << 100 * (1 - (pruned.wallSeconds / std::max<uint64_t>(pruned.txFrames, 1))
+                                / (full.wallSeconds / std::max<uint64_t>(full.txFrames, 1)))
+                  << "%" << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,514 @@
+/*
+ * 다대일 수집(convergecast)용 그룹 ACK
+ *
+ * lr-wpan-csmaca.cc처럼 모든 디바이스가 코디네이터(00:01)에게 보내는 PAN에서 두 방식을 비교합니다.
+ *  - ack  : TX_OPTION_ACK, 프레임마다 turnaround와 개별 ACK 프레임이 필요
+ *  - group: TX_OPTION_NONE으로 보내고, 코디네이터가 창(window)마다 받은 프레임을 디바이스별
+ *           비트맵으로 묶어 브로드캐스트 프레임 하나로 알림. 디바이스는 비트맵에 없는 프레임만 재전송
+ *
+ * 창은 시뮬레이션 시작부터 --window 간격으로 나뉘며 코디네이터와 디바이스가 같은 경계를 사용합니다.
+ * 창 k의 그룹 ACK는 창 k 동안 받은 프레임만 담으므로, 디바이스는 창 k 이하에 전송을 마쳤는데
+ * 아직 확인되지 않은 프레임(프레임 손실 또는 이전 그룹 ACK 손실)을 재전송합니다.
+ * 그룹 ACK가 계속 오지 않으면 3개 창이 지난 뒤 재전송합니다.
+ *
+ * 페이로드 형식
+ *  - 데이터  : [0x01][seq 2 byte][데이터]
+ *  - 그룹 ACK: [0x02][창 번호 4 byte][항목 수 1 byte] + 항목 * ([주소 2 byte][base seq 2 byte][비트맵 4 byte])
+ *    비트맵의 i번째 비트는 base seq + i 프레임 수신 여부. 한 프레임에 13개 항목까지 담고 넘치면 나눠 보냄
+ *
+ * 사용 예:
+ *   ./ns3 run "lr-wpan-group-ack --nodes=20 --interval=0.05 --window=0.05"
+ */
+#include <ns3/core-module.h>
+#include <ns3/lr-wpan-module.h>
+#include <ns3/mobility-module.h>
+#include <ns3/network-module.h>
+#include <ns3/simulator.h>
+
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <set>
+#include <vector>
+
+using namespace ns3;
+
+const int COORDINATOR_PAN_ID = 5;
+
+const uint8_t FRAME_DATA = 0x01;
+const uint8_t FRAME_GROUP_ACK = 0x02;
+
+const uint32_t DATA_HEADER_SIZE = 3;
+const uint32_t GROUP_ACK_HEADER_SIZE = 6;
+const uint32_t GROUP_ACK_ENTRY_SIZE = 8;
+const uint32_t GROUP_ACK_BITMAP_BITS = 32;
+
+/// aMaxMACPayloadSize: aMaxPhyPacketSize(127) - aMinMPDUOverhead(9)
+const uint32_t MAX_MAC_PAYLOAD_SIZE = 118;
+
+/// 데이터 프레임에 담을 수 있는 최대 데이터 크기
+const uint32_t MAX_DATA_SIZE = MAX_MAC_PAYLOAD_SIZE - DATA_HEADER_SIZE;
+
+/// 그룹 ACK 프레임 하나에 담을 수 있는 최대 항목 수 (aMaxMACPayloadSize 기준)
+const uint32_t GROUP_ACK_MAX_ENTRIES = 13;
+
+/// 그룹 ACK를 받지 못했을 때 재전송까지 기다리는 창 수
+const uint32_t GROUP_ACK_TIMEOUT_WINDOWS = 3;
+
+
+/// @brief 실행 설정
+struct GroupAckConfig
+{
+    bool groupAck = true;
+    uint32_t nodeCount = 20;
+    Time interval = MilliSeconds(50);   ///< 디바이스별 데이터 생성 간격
+    Time window = MilliSeconds(50);     ///< 그룹 ACK 창
+    uint32_t payloadSize = 20;
+    uint8_t maxRetries = 3;             ///< 개별 ACK의 macMaxFrameRetries와 같은 의미
+    Time simTime = Seconds(30);
+};
+
+
+/// @brief 전송 중이거나 확인을 기다리는 프레임
+struct PendingFrame
+{
+    Time generated;
+    uint32_t window = UINT32_MAX;   ///< 전송을 마친 창, MAC 큐에 있으면 UINT32_MAX
+    uint8_t retries = 0;
+    uint32_t attempt = 0;           ///< 타임아웃 이벤트가 최신 전송인지 확인하는 번호
+};
+
+
+/// @brief 디바이스(송신자) 상태
+struct Sender
+{
+    Ptr<LrWpanMac> mac;
+    uint16_t address = 0;
+    uint16_t nextSeq = 0;
+    std::map<uint16_t, PendingFrame> pending;
+    std::map<uint8_t, uint16_t> inFlight;   ///< MAC에 넘긴 프레임의 msduHandle -> seq
+};
+
+
+/// @brief 실행 결과
+struct GroupAckResult
+{
+    uint64_t generated = 0;
+    uint64_t delivered = 0;         ///< 코디네이터가 받은 서로 다른 프레임 수
+    uint64_t duplicates = 0;
+    uint64_t transmissions = 0;     ///< 디바이스의 데이터 프레임 전송 시도 수
+    uint64_t retransmissions = 0;
+    uint64_t dropped = 0;           ///< 재시도 한도를 넘겨 포기한 프레임 수
+    uint64_t ackFrames = 0;         ///< 그룹 ACK 프레임 수
+    Time latencySum;                ///< 생성부터 코디네이터 최초 수신까지
+};
+
+
+static GroupAckConfig g_config;
+static GroupAckResult g_result;
+static std::vector<Sender> g_senders;
+static std::map<uint16_t, uint32_t> g_senderIndex;                ///< 주소 -> g_senders 인덱스
+static Ptr<LrWpanMac> g_coordinator;
+static std::map<uint16_t, std::set<uint16_t>> g_received;       ///< 주소 -> 받은 seq (중복 제거)
+static std::map<uint16_t, std::vector<uint16_t>> g_windowRx;     ///< 현재 창에서 받은 seq
+
+
+static uint16_t
+ToUint16(Mac16Address address)
+{
+    uint8_t buffer[2];
+    address.CopyTo(buffer);
+    return (buffer[0] << 8) | buffer[1];
+}
+
+
+static uint32_t
+WindowOf(Time t)
+{
+    return static_cast<uint32_t>(t.GetNanoSeconds() / g_config.window.GetNanoSeconds());
+}
+
+
+static McpsDataRequestParams
+CreateParams(Mac16Address dstAddr, uint8_t txOptions)
+{
+    static uint8_t msduHandle = 0;
+
+    McpsDataRequestParams params;
+    params.m_dstPanId = COORDINATOR_PAN_ID;
+    params.m_srcAddrMode = SHORT_ADDR;
+    params.m_dstAddrMode = SHORT_ADDR;
+    params.m_dstAddr = dstAddr;
+    params.m_msduHandle = msduHandle++;
+    params.m_txOptions = txOptions;
+    return params;
+}
+
+
+/// @brief 프레임 하나를 MAC 큐에 넣습니다.
+/// @param sender 송신 디바이스
+/// @param seq 시퀀스 번호
+static void
+Transmit(Sender& sender, uint16_t seq)
+{
+    uint8_t buffer[MAX_MAC_PAYLOAD_SIZE] = {FRAME_DATA, uint8_t(seq >> 8), uint8_t(seq)};
+    uint32_t size = DATA_HEADER_SIZE + g_config.payloadSize;
+
+    // MAC이 McpsDataRequest() 안에서 바로 confirm할 수 있으므로 요청 전에 msduHandle을 기록
+    McpsDataRequestParams params =
+        CreateParams(Mac16Address("00:01"), g_config.groupAck ? TX_OPTION_NONE : TX_OPTION_ACK);
+    sender.pending[seq].window = UINT32_MAX;
+    sender.inFlight[params.m_msduHandle] = seq;
+    sender.mac->McpsDataRequest(params, Create<Packet>(buffer, size));
+    g_result.transmissions++;
+}
+
+
+/// @brief 확인되지 않은 프레임을 재전송하거나 한도를 넘겼으면 포기합니다.
+static void
+Retransmit(Sender& sender, uint16_t seq)
+{
+    PendingFrame& frame = sender.pending[seq];
+    if(frame.retries >= g_config.maxRetries)
+    {
+        sender.pending.erase(seq);
+        g_result.dropped++;
+        return;
+    }
+    frame.retries++;
+    frame.attempt++;
+    g_result.retransmissions++;
+    Transmit(sender, seq);
+}
+
+
+/// @brief 그룹 ACK가 오지 않은 프레임의 타임아웃
+static void
+AckTimeout(uint32_t index, uint16_t seq, uint32_t attempt)
+{
+    Sender& sender = g_senders[index];
+    auto it = sender.pending.find(seq);
+    if(it == sender.pending.end() || it->second.attempt != attempt || it->second.window == UINT32_MAX)
+        return;
+    Retransmit(sender, seq);
+}
+
+
+/// @brief 새 데이터 프레임을 만들어 보냅니다.
+static void
+Generate(uint32_t index)
+{
+    Sender& sender = g_senders[index];
+    uint16_t seq = sender.nextSeq++;
+
+    sender.pending[seq].generated = Simulator::Now();
+    g_result.generated++;
+    Transmit(sender, seq);
+
+    Simulator::Schedule(g_config.interval, &Generate, index);
+}
+
+
+/// @brief 디바이스의 MCPS-DATA.confirm 콜백
+static void
+SenderDataConfirm(uint32_t index, McpsDataConfirmParams params)
+{
+    Sender& sender = g_senders[index];
+    auto handle = sender.inFlight.find(params.m_msduHandle);
+    if(handle == sender.inFlight.end())
+        return;
+    uint16_t seq = handle->second;
+    sender.inFlight.erase(handle);
+
+    auto it = sender.pending.find(seq);
+    if(it == sender.pending.end())
+        return;
+
+    if(!g_config.groupAck)
+    {
+        // 개별 ACK: 재전송은 MAC이 macMaxFrameRetries만큼 이미 수행함
+        if(params.m_status != IEEE_802_15_4_SUCCESS)
+            g_result.dropped++;
+        sender.pending.erase(it);
+        return;
+    }
+
+    if(params.m_status != IEEE_802_15_4_SUCCESS)
+    {
+        // 채널 접근 실패: 그룹 ACK를 기다릴 필요 없이 바로 재시도
+        Retransmit(sender, seq);
+        return;
+    }
+
+    it->second.window = WindowOf(Simulator::Now());
+    Simulator::Schedule(g_config.window * GROUP_ACK_TIMEOUT_WINDOWS,
+                        &AckTimeout, index, seq, it->second.attempt);
+}
+
+
+/// @brief 디바이스의 MCPS-DATA.indication 콜백: 그룹 ACK 처리
+static void
+SenderDataIndication(uint32_t index, McpsDataIndicationParams params, Ptr<Packet> p)
+{
+    uint8_t buffer[GROUP_ACK_HEADER_SIZE + GROUP_ACK_MAX_ENTRIES * GROUP_ACK_ENTRY_SIZE];
+    uint32_t size = p->CopyData(buffer, sizeof(buffer));
+    if(size < GROUP_ACK_HEADER_SIZE || buffer[0] != FRAME_GROUP_ACK)
+        return;
+
+    Sender& sender = g_senders[index];
+    uint32_t window = (buffer[1] << 24) | (buffer[2] << 16) | (buffer[3] << 8) | buffer[4];
+    uint32_t count = std::min<uint32_t>(buffer[5], (size - GROUP_ACK_HEADER_SIZE) / GROUP_ACK_ENTRY_SIZE);
+
+    bool found = false;
+    uint16_t base = 0;
+    uint32_t bitmap = 0;
+    for(uint32_t i = 0; i < count; i++)
+    {
+        const uint8_t* entry = buffer + GROUP_ACK_HEADER_SIZE + i * GROUP_ACK_ENTRY_SIZE;
+        if(((entry[0] << 8) | entry[1]) != sender.address)
+            continue;
+        base = (entry[2] << 8) | entry[3];
+        bitmap = (entry[4] << 24) | (entry[5] << 16) | (entry[6] << 8) | entry[7];
+        found = true;
+        break;
+    }
+
+    // 한 창의 ACK가 여러 프레임으로 나뉘었을 수 있으므로 가득 찬 프레임에 자신의 항목이 없으면 다음 프레임을 기다림
+    if(!found && count == GROUP_ACK_MAX_ENTRIES)
+        return;
+
+    std::vector<uint16_t> lost;
+    for(auto it = sender.pending.begin(); it != sender.pending.end();)
+    {
+        PendingFrame& frame = it->second;
+        if(frame.window == UINT32_MAX || frame.window > window)
+        {
+            it++;
+            continue;
+        }
+
+        uint16_t offset = it->first - base;
+        if(frame.window == window && offset < GROUP_ACK_BITMAP_BITS && (bitmap >> offset) & 1)
+        {
+            it = sender.pending.erase(it);
+            continue;
+        }
+        lost.push_back(it->first);
+        it++;
+    }
+
+    for(uint16_t seq : lost)
+        Retransmit(sender, seq);
+}
+
+
+/// @brief 코디네이터의 MCPS-DATA.indication 콜백
+static void
+CoordinatorDataIndication(McpsDataIndicationParams params, Ptr<Packet> p)
+{
+    uint8_t header[DATA_HEADER_SIZE];
+    if(p->CopyData(header, DATA_HEADER_SIZE) < DATA_HEADER_SIZE || header[0] != FRAME_DATA)
+        return;
+
+    uint16_t address = ToUint16(params.m_srcAddr);
+    uint16_t seq = (header[1] << 8) | header[2];
+
+    if(g_config.groupAck)
+        g_windowRx[address].push_back(seq);
+
+    if(!g_received[address].insert(seq).second)
+    {
+        g_result.duplicates++;
+        return;
+    }
+    g_result.delivered++;
+
+    // 생성 시각은 송신 측 상태에서 찾음 (시뮬레이션 내 측정용)
+    auto index = g_senderIndex.find(address);
+    if(index == g_senderIndex.end())
+        return;
+    const Sender& sender = g_senders[index->second];
+    auto it = sender.pending.find(seq);
+    if(it != sender.pending.end())
+        g_result.latencySum += Simulator::Now() - it->second.generated;
+}
+
+
+/// @brief 창이 끝날 때 받은 프레임을 비트맵으로 묶어 브로드캐스트합니다.
+/// @param window 끝난 창 번호
+static void
+SendGroupAck(uint32_t window)
+{
+    std::vector<uint8_t> entries;
+    uint32_t count = 0;
+
+    auto flush = [&]() {
+        if(count == 0)
+            return;
+        std::vector<uint8_t> buffer = {FRAME_GROUP_ACK,
+                                       uint8_t(window >> 24), uint8_t(window >> 16),
+                                       uint8_t(window >> 8), uint8_t(window),
+                                       uint8_t(count)};
+        buffer.insert(buffer.end(), entries.begin(), entries.end());
+        g_coordinator->McpsDataRequest(CreateParams(Mac16Address("ff:ff"), TX_OPTION_NONE),
+                                       Create<Packet>(buffer.data(), buffer.size()));
+        g_result.ackFrames++;
+        entries.clear();
+        count = 0;
+    };
+
+    for(const auto& [address, seqs] : g_windowRx)
+    {
+        // 창에서 가장 먼저 받은 seq를 기준으로 이후 32개를 비트맵으로 표시, 넘치는 프레임은 재전송됨
+        uint16_t base = seqs.front();
+        for(uint16_t seq : seqs)
+            if(uint16_t(base - seq) < 0x8000 && base != seq)
+                base = seq;
+
+        uint32_t bitmap = 0;
+        for(uint16_t seq : seqs)
+        {
+            uint16_t offset = seq - base;
+            if(offset < GROUP_ACK_BITMAP_BITS)
+                bitmap |= 1U << offset;
+        }
+
+        uint8_t entry[GROUP_ACK_ENTRY_SIZE] = {uint8_t(address >> 8), uint8_t(address),
+                                               uint8_t(base >> 8), uint8_t(base),
+                                               uint8_t(bitmap >> 24), uint8_t(bitmap >> 16),
+                                               uint8_t(bitmap >> 8), uint8_t(bitmap)};
+        entries.insert(entries.end(), entry, entry + GROUP_ACK_ENTRY_SIZE);
+        if(++count == GROUP_ACK_MAX_ENTRIES)
+            flush();
+    }
+    flush();
+    g_windowRx.clear();
+
+    Simulator::Schedule(g_config.window, &SendGroupAck, window + 1);
+}
+
+
+/// @brief 한 방식으로 시나리오를 실행합니다.
+static GroupAckResult
+Run(const GroupAckConfig& config)
+{
+    g_config = config;
+    g_result = GroupAckResult();
+    g_senders.clear();
+    g_senderIndex.clear();
+    g_received.clear();
+    g_windowRx.clear();
+    RngSeedManager::SetSeed(1);
+    RngSeedManager::SetRun(1);
+
+    NodeContainer pan;
+    pan.Create(config.nodeCount);
+
+    MobilityHelper mobilityHelper;
+    mobilityHelper.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+    mobilityHelper.SetPositionAllocator("ns3::UniformDiscPositionAllocator",
+                                        "rho", DoubleValue(20.0));
+    mobilityHelper.Install(pan);
+
+    LrWpanHelper lrWpanHelper;
+    NetDeviceContainer netDevices = lrWpanHelper.Install(pan);
+    lrWpanHelper.CreateAssociatedPan(netDevices, COORDINATOR_PAN_ID);
+
+    g_coordinator = DynamicCast<LrWpanNetDevice>(netDevices.Get(0))->GetMac();
+    g_coordinator->SetMcpsDataIndicationCallback(MakeCallback(&CoordinatorDataIndication));
+
+    g_senders.resize(netDevices.GetN() - 1);
+    Ptr<UniformRandomVariable> jitter = CreateObject<UniformRandomVariable>();
+    for(uint32_t i = 1; i < netDevices.GetN(); i++)
+    {
+        Sender& sender = g_senders[i - 1];
+        sender.mac = DynamicCast<LrWpanNetDevice>(netDevices.Get(i))->GetMac();
+        sender.address = ToUint16(sender.mac->GetShortAddress());
+        g_senderIndex[sender.address] = i - 1;
+        sender.mac->SetMacMaxFrameRetries(config.maxRetries);
+        sender.mac->SetMcpsDataConfirmCallback(MakeBoundCallback(&SenderDataConfirm, i - 1));
+        sender.mac->SetMcpsDataIndicationCallback(MakeBoundCallback(&SenderDataIndication, i - 1));
+
+        Simulator::ScheduleWithContext(pan.Get(i)->GetId(),
+                                       Seconds(1 + jitter->GetValue(0, config.interval.GetSeconds())),
+                                       &Generate,
+                                       i - 1);
+    }
+
+    if(config.groupAck)
+    {
+        uint32_t first = WindowOf(Seconds(1));
+        Simulator::ScheduleWithContext(pan.Get(0)->GetId(),
+                                       config.window * (first + 1),
+                                       &SendGroupAck,
+                                       first);
+    }
+
+    Simulator::Stop(config.simTime);
+    Simulator::Run();
+    Simulator::Destroy();
+    g_senders.clear();
+    g_coordinator = nullptr;
+
+    return g_result;
+}
+
+
+int main(int argc, char* argv[])
+{
+    GroupAckConfig config;
+    std::string mode = "both";
+    double interval = config.interval.GetSeconds();
+    double window = config.window.GetSeconds();
+    double simTime = config.simTime.GetSeconds();
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("mode", "ack, group, both", mode);
+    cmd.AddValue("nodes", "코디네이터를 포함한 노드 수", config.nodeCount);
+    cmd.AddValue("interval", "디바이스별 데이터 생성 간격 (s)", interval);
+    cmd.AddValue("window", "그룹 ACK 창 (s)", window);
+    cmd.AddValue("payload", "데이터 크기 (byte)", config.payloadSize);
+    cmd.AddValue("retries", "최대 재전송 횟수", config.maxRetries);
+    cmd.AddValue("simTime", "시뮬레이션 시간 (s)", simTime);
+    cmd.Parse(argc, argv);
+
+    NS_ABORT_MSG_IF(mode != "ack" && mode != "group" && mode != "both", "unknown mode: " << mode);
+    NS_ABORT_MSG_IF(config.nodeCount < 2, "at least two nodes are required");
+    NS_ABORT_MSG_IF(config.payloadSize > MAX_DATA_SIZE,
+                    "payload must not exceed " << MAX_DATA_SIZE << " bytes (aMaxMACPayloadSize minus the data header)");
+    config.interval = Seconds(interval);
+    config.window = Seconds(window);
+    config.simTime = Seconds(simTime);
+
+    auto print = [&](const std::string& title, const GroupAckResult& result) {
+        double activeSeconds = simTime - 1;
+        std::cout
+            << std::left << std::setw(8) << title
+            << std::fixed << std::setprecision(3)
+            << "generated " << result.generated
+            << ", delivered " << result.delivered
+            << " (" << (result.generated ? 100.0 * result.delivered / result.generated : 0) << "%)"
+            << ", goodput " << result.delivered / activeSeconds << " frames/s"
+            << ", latency " << (result.delivered ? result.latencySum.GetSeconds() * 1e3 / result.delivered : 0) << " ms"
+            << ", tx " << result.transmissions
+            << ", retx " << result.retransmissions
+            << ", dup " << result.duplicates
+            << ", dropped " << result.dropped
+            << ", group ACK frames " << result.ackFrames
+            << std::endl
+        ;
+    };
+
+    if(mode != "group")
+    {
+        config.groupAck = false;
+        print("ack", Run(config));
+    }
+    if(mode != "ack")
+    {
+        config.groupAck = true;
+        print("group", Run(config));
+    }
+
+    return 0;
+}
@@ -0,0 +1,534 @@
+/*
+ * 이동 디바이스의 코디네이터 간 핸드오버
+ *
+ * 비콘 모드 코디네이터 여러 개를 x축을 따라 서로 다른 채널에 두고, 디바이스는
+ * ConstantVelocityMobilityModel로 코디네이터들을 지나가며 이동합니다.
+ *
+ * 1. 처음에는 lr-wpan-superframe.cc와 같이 MLME-SCAN → LQI가 가장 좋은 코디네이터에 MLME-ASSOCIATE로 연결하고,
+ *    MLME-SYNC.request로 그 PAN의 비콘을 추적합니다.
+ * 2. 디바이스는 자기 PAN 비콘의 수신 품질(PHY가 LQI를 계산하는 데 쓰는 SINR, dB)을 지수 이동 평균으로 추적하고,
+ *    --sinrThreshold 아래로 떨어지거나 MLME-SYNC-LOSS.indication을 받으면 핸드오버를 시작합니다.
+ * 3. 비콘 추적을 멈추고(MLME-SYNC.request, m_trackBcn = false) 코디네이터 채널들을 PASSIVE 스캔한 뒤,
+ *    처음 연결할 때와 같은 선택 로직(가장 높은 LQI)으로 후보를 고릅니다. 후보의 LQI가 현재 코디네이터보다
+ *    --lqiMargin 이상 높을 때만 다시 연결하고 새 채널의 비콘을 추적합니다(히스테리시스). 현재 코디네이터가
+ *    스캔에서 보이지 않으면 바로 후보로 옮깁니다.
+ * 4. 핸드오버를 취소하면 현재 PAN의 비콘 추적을 다시 시작하고, --holdOff 동안은 SINR로 핸드오버를 시작하지
+ *    않습니다. 연속으로 취소될 때마다 대기 시간을 두 배로(최대 8배) 늘리고, 핸드오버에 성공하면 되돌립니다.
+ *    MLME-SYNC-LOSS.indication은 대기 중에도 바로 핸드오버를 시작합니다.
+ *
+ * 핸드오버 지연(시작 ~ MLME-ASSOCIATE.confirm 성공)과 핸드오버 중 잃은 데이터
+ * (연결되지 않아 보내지 못한 프레임 + MCPS-DATA.confirm 실패)를 디바이스별 / 전체로 출력합니다.
+ *
+ * 경로 손실은 SpectrumChannel이 전송할 때마다 송수신 노드의 현재 위치로 계산하므로, 디바이스가 움직여도
+ * 다시 계산해야 할 링크 캐시가 없고 움직인 노드가 참여하는 링크만 값이 바뀝니다.
+ *
+ * 사용 예:
+ *   ./ns3 run "lr-wpan-handover --coordinators=3 --devices=4 --speed=2 --simTime=150"
+ */
+#include <ns3/core-module.h>
+#include <ns3/lr-wpan-module.h>
+#include <ns3/simulator.h>
+
+#include <ns3/network-module.h>
+
+// channel
+#include <ns3/propagation-module.h>
+#include <ns3/spectrum-module.h>
+
+// mobility model
+#include <ns3/mobility-helper.h>
+#include <ns3/mobility-module.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+using namespace ns3;
+
+const uint8_t FIRST_CHANNEL = 11;
+
+
+/// @brief 디바이스의 연결 상태
+enum class LinkState
+{
+    SCANNING,       ///< 처음 연결 또는 핸드오버를 위한 스캔 중
+    ASSOCIATING,    ///< MLME-ASSOCIATE.confirm 대기
+    ASSOCIATED,
+};
+
+
+/// @brief 이동 디바이스 상태
+struct MobileDevice
+{
+    Ptr<LrWpanNetDevice> netDevice;
+    LinkState state = LinkState::SCANNING;
+    bool handover = false;          ///< 진행 중인 스캔 / 연결이 핸드오버인지 (처음 연결이면 false)
+    uint16_t panId = 0;
+    uint8_t channel = 0;
+    Mac16Address coordinator;
+    PanDescriptor target;           ///< 연결을 요청한 코디네이터
+    double sinrDb = 0;              ///< 비콘 SINR 지수 이동 평균
+    bool sinrValid = false;
+    Time handoverStart;
+    Time holdOffUntil;              ///< 이 시각까지 SINR로 핸드오버를 시작하지 않음
+    uint32_t consecutiveCancels = 0;
+
+    std::vector<Time> handoverLatency;
+    uint32_t cancelled = 0;         ///< 히스테리시스로 취소된 핸드오버 수
+    uint32_t sent = 0;
+    uint32_t failed = 0;
+    uint32_t lostDuringHandover = 0;
+};
+
+
+/// @brief 실행 설정
+struct HandoverOptions
+{
+    uint32_t coordinatorCount = 3;
+    uint32_t deviceCount = 4;
+    double coordinatorSpacing = 80;     ///< 코디네이터 간격 (m)
+    double speed = 2;                   ///< 디바이스 속도 (m/s)
+    uint8_t bcnOrd = 5;                 ///< BO = SO (활성 구간만 있는 비콘 PAN)
+    double sinrThresholdDb = 6;
+    double sinrAlpha = 0.3;             ///< 이동 평균 가중치
+    uint32_t lqiMargin = 16;            ///< 후보가 현재 코디네이터보다 높아야 하는 LQI
+    double holdOff = 5;                 ///< 핸드오버 취소 뒤 대기 시간 (s)
+    double interval = 0.2;              ///< 디바이스별 전송 간격 (s)
+    double simTime = 150;
+};
+
+static HandoverOptions g_options;
+static std::vector<MobileDevice> g_devices;
+static std::vector<uint32_t> g_delivered;     ///< 코디네이터별 수신 프레임 수
+
+
+/// @brief 스캔할 채널 비트맵: 코디네이터가 사용하는 채널
+static uint32_t
+ScanChannels()
+{
+    uint32_t channels = 0;
+    for(uint32_t i = 0; i < g_options.coordinatorCount; i++)
+        channels |= 1U << (FIRST_CHANNEL + i);
+    return channels;
+}
+
+
+/// @brief PASSIVE 스캔을 시작합니다. 비콘 간격(BO) 동안 채널마다 비콘을 기다립니다.
+static void
+StartScan(uint32_t index)
+{
+    MobileDevice& device = g_devices[index];
+    device.state = LinkState::SCANNING;
+
+    MlmeScanRequestParams scanParams;
+    scanParams.m_chPage = 0;
+    scanParams.m_scanChannels = ScanChannels();
+    scanParams.m_scanDuration = g_options.bcnOrd;
+    scanParams.m_scanType = MLMESCAN_PASSIVE;
+    device.netDevice->GetMac()->MlmeScanRequest(scanParams);
+}
+
+
+/// @brief 핸드오버를 시작합니다. 스캔이 채널을 바꾸므로 먼저 현재 PAN의 비콘 추적을 멈춥니다.
+static void
+StartHandover(uint32_t index)
+{
+    MobileDevice& device = g_devices[index];
+    if(device.state != LinkState::ASSOCIATED)
+        return;
+
+    device.handover = true;
+    device.handoverStart = Simulator::Now();
+    device.sinrValid = false;
+
+    MlmeSyncRequestParams syncParams;
+    syncParams.m_logCh = device.channel;
+    syncParams.m_trackBcn = false;
+    device.netDevice->GetMac()->MlmeSyncRequest(syncParams);
+
+    StartScan(index);
+}
+
+
+/// @brief MLME-SCAN.confirm 콜백: 가장 LQI가 좋은 코디네이터에 MLME-ASSOCIATE.request를 보냅니다.
+/// lr-wpan-superframe.cc의 MlmeScanConfirm과 같은 선택 로직입니다.
+static void
+MlmeScanConfirm(uint32_t index, MlmeScanConfirmParams params)
+{
+    MobileDevice& device = g_devices[index];
+
+    if((params.m_status != MLMESCAN_SUCCESS && params.m_status != MLMESCAN_NO_BEACON) ||
+       params.m_panDescList.empty())
+    {
+        // 비콘을 찾지 못함: 잠시 뒤 다시 스캔
+        Simulator::Schedule(Seconds(1), &StartScan, index);
+        return;
+    }
+
+    int maxLqi = 0, maxLqiPanDescIdx = 0;
+    for(uint32_t i = 0; i < params.m_panDescList.size(); i++)
+    {
+        if(params.m_panDescList[i].m_linkQuality > maxLqi)
+        {
+            maxLqi = params.m_panDescList[i].m_linkQuality;
+            maxLqiPanDescIdx = i;
+        }
+    }
+    PanDescriptor targetCoordinator = params.m_panDescList[maxLqiPanDescIdx];
+
+    // 현재 코디네이터가 보이면, 후보가 lqiMargin 이상 좋을 때만 옮김
+    bool stay = false;
+    if(device.handover)
+    {
+        for(const PanDescriptor& descriptor : params.m_panDescList)
+        {
+            if(descriptor.m_coorPanId == device.panId &&
+               descriptor.m_linkQuality + g_options.lqiMargin > targetCoordinator.m_linkQuality)
+            {
+                stay = true;
+                break;
+            }
+        }
+    }
+
+    // 핸드오버 취소: 비콘 추적을 다시 시작하고, 연속 취소마다 대기 시간을 두 배로 늘림
+    if(stay)
+    {
+        device.state = LinkState::ASSOCIATED;
+        device.handover = false;
+        device.cancelled++;
+        device.holdOffUntil = Simulator::Now() +
+                              Seconds(g_options.holdOff * (1 << std::min<uint32_t>(device.consecutiveCancels, 3)));
+        device.consecutiveCancels++;
+
+        MlmeSyncRequestParams syncParams;
+        syncParams.m_logCh = device.channel;
+        syncParams.m_trackBcn = true;
+        device.netDevice->GetMac()->MlmeSyncRequest(syncParams);
+        return;
+    }
+
+    MlmeAssociateRequestParams mlmeAssociateRequestParams;
+    mlmeAssociateRequestParams.m_chNum = targetCoordinator.m_logCh;
+    mlmeAssociateRequestParams.m_chPage = targetCoordinator.m_logChPage;
+    mlmeAssociateRequestParams.m_coordPanId = targetCoordinator.m_coorPanId;
+    mlmeAssociateRequestParams.m_capabilityInfo.SetShortAddrAllocOn(true);
+    mlmeAssociateRequestParams.m_coordShortAddr = targetCoordinator.m_coorShortAddr;
+    mlmeAssociateRequestParams.m_coordAddrMode = targetCoordinator.m_coorAddrMode;
+
+    device.state = LinkState::ASSOCIATING;
+    device.target = targetCoordinator;
+    Simulator::ScheduleNow(&LrWpanMac::MlmeAssociateRequest,
+                           device.netDevice->GetMac(),
+                           mlmeAssociateRequestParams);
+}
+
+
+/// @brief MLME-ASSOCIATE.confirm 콜백: 연결되면 새 PAN의 비콘을 추적합니다.
+static void
+MlmeAssociateConfirm(uint32_t index, MlmeAssociateConfirmParams params)
+{
+    MobileDevice& device = g_devices[index];
+
+    if(params.m_status != MLMEASSOC_SUCCESS)
+    {
+        Simulator::Schedule(Seconds(1), &StartScan, index);
+        return;
+    }
+
+    device.state = LinkState::ASSOCIATED;
+    device.panId = device.target.m_coorPanId;
+    device.channel = device.target.m_logCh;
+    device.coordinator = device.target.m_coorShortAddr;
+    device.sinrValid = false;
+
+    if(device.handover)
+    {
+        device.handoverLatency.push_back(Simulator::Now() - device.handoverStart);
+        device.handover = false;
+        device.consecutiveCancels = 0;
+        std::cout << Simulator::Now().As(Time::S) << ": device " << index
+                  << " handed over to PAN " << device.panId
+                  << " (channel " << +device.channel << ") in "
+                  << device.handoverLatency.back().As(Time::MS) << std::endl;
+    }
+
+    MlmeSyncRequestParams syncParams;
+    syncParams.m_logCh = device.channel;
+    syncParams.m_trackBcn = true;
+    Simulator::ScheduleNow(&LrWpanMac::MlmeSyncRequest, device.netDevice->GetMac(), syncParams);
+}
+
+
+/// @brief 비콘을 잃으면 바로 핸드오버를 시작합니다.
+static void
+MlmeSyncLossIndication(uint32_t index, MlmeSyncLossIndicationParams params)
+{
+    StartHandover(index);
+}
+
+
+/// @brief PHY 수신 완료 trace: 자기 PAN 비콘의 SINR을 추적합니다.
+static void
+PhyRxEnd(uint32_t index, Ptr<const Packet> p, double sinr)
+{
+    MobileDevice& device = g_devices[index];
+    if(device.state != LinkState::ASSOCIATED || sinr <= 0)
+        return;
+
+    Ptr<Packet> copy = p->Copy();
+    LrWpanMacHeader header;
+    if(copy->RemoveHeader(header) == 0 || !header.IsBeacon() || header.GetSrcPanId() != device.panId)
+        return;
+
+    double sinrDb = 10 * std::log10(sinr);
+    device.sinrDb = device.sinrValid ? (1 - g_options.sinrAlpha) * device.sinrDb + g_options.sinrAlpha * sinrDb
+                                     : sinrDb;
+    device.sinrValid = true;
+
+    if(device.sinrDb < g_options.sinrThresholdDb && Simulator::Now() >= device.holdOffUntil)
+        Simulator::ScheduleNow(&StartHandover, index);
+}
+
+
+/// @brief 연결되어 있으면 코디네이터에게 데이터를 보내고, 아니면 잃은 데이터로 셉니다.
+static void
+SendData(uint32_t index)
+{
+    static uint8_t msduHandle = 0;
+    MobileDevice& device = g_devices[index];
+
+    Simulator::Schedule(Seconds(g_options.interval), &SendData, index);
+
+    if(device.state != LinkState::ASSOCIATED)
+    {
+        if(device.handover)
+            device.lostDuringHandover++;
+        return;
+    }
+
+    McpsDataRequestParams params;
+    params.m_dstPanId = device.panId;
+    params.m_srcAddrMode = SHORT_ADDR;
+    params.m_dstAddrMode = SHORT_ADDR;
+    params.m_dstAddr = device.coordinator;
+    params.m_msduHandle = msduHandle++;
+    params.m_txOptions = TX_OPTION_ACK;
+
+    device.netDevice->GetMac()->McpsDataRequest(params, Create<Packet>(20));
+    device.sent++;
+}
+
+
+static void
+McpsDataConfirm(uint32_t index, McpsDataConfirmParams params)
+{
+    MobileDevice& device = g_devices[index];
+    if(params.m_status == IEEE_802_15_4_SUCCESS)
+        return;
+
+    device.failed++;
+    if(device.handover)
+        device.lostDuringHandover++;
+}
+
+
+/// @brief 코디네이터의 MLME-ASSOCIATE.indication 콜백: 짧은 주소를 할당해 응답합니다.
+static void
+MlmeAssociateIndication(Ptr<LrWpanNetDevice> coordinator, MlmeAssociateIndicationParams params)
+{
+    static uint16_t rawAddr = 0x0100;
+
+    MlmeAssociateResponseParams assocRespParams;
+    assocRespParams.m_extDevAddr = params.m_extDevAddr;
+    assocRespParams.m_status = LrWpanAssociationStatus::ASSOCIATED;
+    assocRespParams.m_assocShortAddr = Mac16Address(rawAddr++);
+
+    Simulator::ScheduleNow(&LrWpanMac::MlmeAssociateResponse, coordinator->GetMac(), assocRespParams);
+}
+
+
+static void
+CoordinatorDataIndication(uint32_t coordinator, McpsDataIndicationParams params, Ptr<Packet> p)
+{
+    g_delivered[coordinator]++;
+}
+
+
+int main(int argc, char* argv[])
+{
+    uint32_t bcnOrd = g_options.bcnOrd;
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("coordinators", "코디네이터 수 (채널 11부터 하나씩)", g_options.coordinatorCount);
+    cmd.AddValue("devices", "이동 디바이스 수", g_options.deviceCount);
+    cmd.AddValue("spacing", "코디네이터 간격 (m)", g_options.coordinatorSpacing);
+    cmd.AddValue("speed", "디바이스 속도 (m/s)", g_options.speed);
+    cmd.AddValue("bo", "macBeaconOrder = macSuperframeOrder", bcnOrd);
+    cmd.AddValue("sinrThreshold", "핸드오버를 시작하는 비콘 SINR (dB)", g_options.sinrThresholdDb);
+    cmd.AddValue("lqiMargin", "후보 코디네이터가 현재 코디네이터보다 높아야 하는 LQI", g_options.lqiMargin);
+    cmd.AddValue("holdOff", "핸드오버 취소 뒤 SINR로 다시 시작하기까지의 대기 시간 (s)", g_options.holdOff);
+    cmd.AddValue("interval", "디바이스별 전송 간격 (s)", g_options.interval);
+    cmd.AddValue("simTime", "시뮬레이션 시간 (s)", g_options.simTime);
+    cmd.Parse(argc, argv);
+
+    NS_ABORT_MSG_IF(bcnOrd > 14, "beacon-enabled coordinators are required (bo <= 14)");
+    NS_ABORT_MSG_IF(g_options.coordinatorCount == 0 || g_options.coordinatorCount > 16, "1 to 16 coordinators");
+    g_options.bcnOrd = bcnOrd;
+
+    Ptr<SingleModelSpectrumChannel> channel = CreateObject<SingleModelSpectrumChannel>();
+    channel->AddPropagationLossModel(CreateObject<LogDistancePropagationLossModel>());
+    channel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
+
+    LrWpanHelper lrWpanHelper;
+    lrWpanHelper.SetChannel(channel);
+
+    // 코디네이터: x축을 따라 배치, 서로 다른 채널에서 비콘 PAN 시작
+    NodeContainer coordinators;
+    coordinators.Create(g_options.coordinatorCount);
+    MobilityHelper coordinatorMobility;
+    coordinatorMobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+    coordinatorMobility.SetPositionAllocator("ns3::GridPositionAllocator",
+                                             "MinX", DoubleValue(0.0),
+                                             "MinY", DoubleValue(0.0),
+                                             "DeltaX", DoubleValue(g_options.coordinatorSpacing),
+                                             "DeltaY", DoubleValue(0.0),
+                                             "GridWidth", UintegerValue(g_options.coordinatorCount),
+                                             "LayoutType", StringValue("RowFirst"));
+    coordinatorMobility.Install(coordinators);
+
+    NetDeviceContainer coordinatorDevices = lrWpanHelper.Install(coordinators);
+    g_delivered.assign(g_options.coordinatorCount, 0);
+    for(uint32_t i = 0; i < coordinatorDevices.GetN(); i++)
+    {
+        Ptr<LrWpanNetDevice> netDevice = DynamicCast<LrWpanNetDevice>(coordinatorDevices.Get(i));
+        netDevice->GetMac()->SetShortAddress(Mac16Address(static_cast<uint16_t>(i + 1)));
+        netDevice->GetMac()->SetMlmeAssociateIndicationCallback(
+            MakeBoundCallback(&MlmeAssociateIndication, netDevice));
+        netDevice->GetMac()->SetMcpsDataIndicationCallback(
+            MakeBoundCallback(&CoordinatorDataIndication, i));
+
+        MlmeStartRequestParams params;
+        params.m_panCoor = true;
+        params.m_PanId = i + 1;
+        params.m_bcnOrd = g_options.bcnOrd;
+        params.m_sfrmOrd = g_options.bcnOrd;
+        params.m_logCh = FIRST_CHANNEL + i;
+        params.m_coorRealgn = false;
+        Simulator::ScheduleWithContext(coordinators.Get(i)->GetId(),
+                                       Seconds(1.0),
+                                       &LrWpanMac::MlmeStartRequest,
+                                       netDevice->GetMac(),
+                                       params);
+    }
+
+    // 디바이스: 첫 코디네이터 근처에서 출발해 +x 방향으로 이동
+    NodeContainer devices;
+    devices.Create(g_options.deviceCount);
+    MobilityHelper deviceMobility;
+    deviceMobility.SetMobilityModel("ns3::ConstantVelocityMobilityModel");
+    deviceMobility.SetPositionAllocator("ns3::GridPositionAllocator",
+                                        "MinX", DoubleValue(-10.0),
+                                        "MinY", DoubleValue(-6.0),
+                                        "DeltaX", DoubleValue(0.0),
+                                        "DeltaY", DoubleValue(4.0),
+                                        "GridWidth", UintegerValue(1),
+                                        "LayoutType", StringValue("RowFirst"));
+    deviceMobility.Install(devices);
+
+    NetDeviceContainer deviceNetDevices = lrWpanHelper.Install(devices);
+    g_devices.resize(deviceNetDevices.GetN());
+    for(uint32_t i = 0; i < deviceNetDevices.GetN(); i++)
+    {
+        MobileDevice& device = g_devices[i];
+        device.netDevice = DynamicCast<LrWpanNetDevice>(deviceNetDevices.Get(i));
+
+        devices.Get(i)->GetObject<ConstantVelocityMobilityModel>()->SetVelocity(Vector(g_options.speed, 0, 0));
+
+        Ptr<LrWpanMac> mac = device.netDevice->GetMac();
+        mac->SetMlmeScanConfirmCallback(MakeBoundCallback(&MlmeScanConfirm, i));
+        mac->SetMlmeAssociateConfirmCallback(MakeBoundCallback(&MlmeAssociateConfirm, i));
+        mac->SetMlmeSyncLossIndicationCallback(MakeBoundCallback(&MlmeSyncLossIndication, i));
+        mac->SetMcpsDataConfirmCallback(MakeBoundCallback(&McpsDataConfirm, i));
+        device.netDevice->GetPhy()->TraceConnectWithoutContext("PhyRxEnd", MakeBoundCallback(&PhyRxEnd, i));
+
+        // 연결 요청이 몰리지 않도록 디바이스마다 100 ms씩 어긋나게 스캔 시작
+        Simulator::ScheduleWithContext(devices.Get(i)->GetId(),
+                                       Seconds(2) + MilliSeconds(i * 100),
+                                       &StartScan,
+                                       i);
+        Simulator::ScheduleWithContext(devices.Get(i)->GetId(),
+                                       Seconds(2) + MilliSeconds(i * 100) + Seconds(g_options.interval),
+                                       &SendData,
+                                       i);
+    }
+
+    Simulator::Stop(Seconds(g_options.simTime));
+    Simulator::Run();
+
+    std::vector<Time> all;
+    uint32_t totalSent = 0;
+    uint32_t totalFailed = 0;
+    uint32_t totalLost = 0;
+    uint32_t totalCancelled = 0;
+
+    std::cout << std::endl
+              << std::right
+              << std::setw(7) << "device"
+              << std::setw(11) << "handovers"
+              << std::setw(11) << "cancelled"
+              << std::setw(14) << "mean(ms)"
+              << std::setw(14) << "max(ms)"
+              << std::setw(8) << "sent"
+              << std::setw(8) << "failed"
+              << std::setw(16) << "lost(handover)"
+              << std::endl;
+
+    for(uint32_t i = 0; i < g_devices.size(); i++)
+    {
+        const MobileDevice& device = g_devices[i];
+        Time sum;
+        Time max;
+        for(const Time& latency : device.handoverLatency)
+        {
+            sum += latency;
+            max = std::max(max, latency);
+            all.push_back(latency);
+        }
+
+        std::cout << std::fixed << std::setprecision(1)
+                  << std::setw(7) << i
+                  << std::setw(11) << device.handoverLatency.size()
+                  << std::setw(11) << device.cancelled
+                  << std::setw(14) << (device.handoverLatency.empty() ? 0 : sum.GetSeconds() * 1e3 / device.handoverLatency.size())
+                  << std::setw(14) << max.GetSeconds() * 1e3
+                  << std::setw(8) << device.sent
+                  << std::setw(8) << device.failed
+                  << std::setw(16) << device.lostDuringHandover
+                  << std::endl;
+
+        totalSent += device.sent;
+        totalFailed += device.failed;
+        totalLost += device.lostDuringHandover;
+        totalCancelled += device.cancelled;
+    }
+
+    std::sort(all.begin(), all.end());
+    std::cout << "handovers " << all.size() << " (cancelled " << totalCancelled << ")";
+    if(!all.empty())
+    {
+        std::cout << ", median " << all[all.size() / 2].As(Time::MS)
+                  << ", p95 " << all[std::min<size_t>(all.size() - 1, std::ceil(0.95 * all.size()) - 1)].As(Time::MS);
+    }
+    std::cout << ", sent " << totalSent << ", failed " << totalFailed
+              << ", lost during handover " << totalLost << std::endl;
+
+    for(uint32_t i = 0; i < g_delivered.size(); i++)
+        std::cout << "coordinator " << i + 1 << " (channel " << FIRST_CHANNEL + i << ") received " << g_delivered[i] << std::endl;
+
+    Simulator::Destroy();
+
+    return 0;
+}
@@ -0,0 +1,516 @@
+/*
+ * 다중 코디네이터 / 다중 채널 PAN 구성
+ *
+ * 1. 코디네이터는 순서대로 부팅하며 MLME-SCAN(ACTIVE)으로 이미 시작된 PAN을 찾고,
+ *    MLME-SCAN(ED)으로 채널별 에너지를 측정한 뒤 가장 한산한 채널에서 PAN을 시작합니다.
+ * 2. 코디네이터는 연결을 받아들인 디바이스 수를 비콘 페이로드(macBeaconPayload)로 알립니다.
+ *    디바이스는 MLME-SCAN(ACTIVE) 중 받은 비콘(MLME-BEACON-NOTIFY.indication)의 페이로드에서 PAN의 부하를
+ *    읽고, LQI와 함께 고려해 연결할 코디네이터를 선택합니다.
+ * 3. 연결이 끝난 디바이스는 자신의 코디네이터에게 주기적으로 데이터를 보내고,
+ *    시뮬레이션이 끝나면 PAN별 / 전체 수신 처리량을 출력합니다.
+ *
+ * 사용 예 (단일 코디네이터와 비교):
+ *   ./ns3 run "lr-wpan-multichannel --coordinators=1"
+ *   ./ns3 run "lr-wpan-multichannel --coordinators=4"
+ */
+#include <ns3/core-module.h>
+#include <ns3/lr-wpan-module.h>
+#include <ns3/simulator.h>
+
+#include <ns3/network-module.h>
+
+// channel
+#include <ns3/propagation-module.h>
+#include <ns3/spectrum-module.h>
+
+// mobility model
+#include <ns3/mobility-helper.h>
+#include <ns3/mobility-module.h>
+
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <vector>
+
+using namespace ns3;
+
+
+/// 코디네이터가 탐색하는 채널: 2.4 GHz O-QPSK 채널 11 ~ 26
+static uint32_t g_scanChannels = 0x07FFF800;
+
+/// 비콘 미사용 PAN의 비콘 응답을 기다리는 시간: aBaseSuperframeDuration * (2^n + 1) 심볼
+static uint8_t g_scanDuration = 3;
+
+/// PAN 선택 시 연결된 디바이스 한 대가 LQI 몇 만큼의 불이익에 해당하는지
+static double g_loadWeight = 8.0;
+
+/// 디바이스별 데이터 전송 간격
+static Time g_interval = MilliSeconds(100);
+
+/// MSDU 크기 (byte)
+static uint32_t g_payloadSize = 50;
+
+/// 비콘 페이로드: [연결을 받아들인 디바이스 수 2]
+const uint32_t BEACON_PAYLOAD_SIZE = 2;
+
+
+/// @brief 코디네이터가 관리하는 PAN 상태, PAN ID로 찾습니다.
+struct PanState
+{
+    Mac16Address coordinator;
+    uint8_t channel = 0;
+    uint32_t load = 0;              ///< 연결되었거나 연결 중인 디바이스 수, 비콘 페이로드로 알림
+    uint64_t receivedBytes = 0;
+    uint32_t receivedPackets = 0;
+};
+
+/// PAN ID -> PAN 상태, 각 코디네이터는 자기 PAN만 갱신합니다.
+static std::map<uint16_t, PanState> g_pans;
+
+/// @brief 디바이스가 연결한 PAN
+struct DeviceLink
+{
+    uint16_t panId = 0;
+    Mac16Address coordinator;
+};
+
+/// 디바이스 -> 연결한 PAN
+static std::map<Ptr<LrWpanNetDevice>, DeviceLink> g_deviceLinks;
+
+/// 디바이스 -> (PAN ID -> 스캔 중 받은 비콘이 알린 부하)
+static std::map<Ptr<LrWpanNetDevice>, std::map<uint16_t, uint32_t>> g_beaconLoads;
+
+
+/////////////////////////// COORDINATOR ///////////////////////////
+
+/// @brief PAN의 현재 부하를 비콘 페이로드에 기록합니다. 이후 보내는 비콘부터 반영됩니다.
+/// @param device Ptr<LrWpanNetDevice>
+/// @param load 연결되었거나 연결 중인 디바이스 수
+static void
+AdvertiseLoad(Ptr<LrWpanNetDevice> device, uint32_t load)
+{
+    uint8_t payload[BEACON_PAYLOAD_SIZE] = {
+        static_cast<uint8_t>(std::min<uint32_t>(load, 0xFFFF) >> 8),
+        static_cast<uint8_t>(std::min<uint32_t>(load, 0xFFFF)),
+    };
+
+    Ptr<MacPibAttributes> attribute = Create<MacPibAttributes>();
+    attribute->macBeaconPayload = Create<Packet>(payload, BEACON_PAYLOAD_SIZE);
+    device->GetMac()->MlmeSetRequest(MacPibAttributeIdentifier::macBeaconPayload, attribute);
+}
+
+
+/// @brief 코디네이터의 MLME-SCAN.confirm 콜백 함수
+/// ACTIVE 스캔이 끝나면 ED 스캔을 시작하고, ED 스캔이 끝나면 가장 한산한 채널에서 PAN을 시작합니다.
+/// @param device Ptr<LrWpanNetDevice>
+/// @param panId 시작할 PAN ID
+/// @param params MlmeScanConfirmParams
+static void
+CoordinatorScanConfirm(Ptr<LrWpanNetDevice> device, uint16_t panId, MlmeScanConfirmParams params)
+{
+    static std::map<uint16_t, std::vector<uint32_t>> pansPerChannel;
+
+    if(params.m_scanType == MLMESCAN_ACTIVE)
+    {
+        // 1. 이미 시작된 PAN의 채널별 개수를 세고 ED 스캔 시작
+        std::vector<uint32_t>& count = pansPerChannel[panId];
+        count.assign(27, 0);
+        for(const PanDescriptor& descriptor : params.m_panDescList)
+            count[descriptor.m_logCh]++;
+
+        MlmeScanRequestParams scanParams;
+        scanParams.m_chPage = 0;
+        scanParams.m_scanChannels = g_scanChannels;
+        scanParams.m_scanDuration = g_scanDuration;
+        scanParams.m_scanType = MLMESCAN_ED;
+        Simulator::ScheduleNow(&LrWpanMac::MlmeScanRequest, device->GetMac(), scanParams);
+        return;
+    }
+
+    if(params.m_scanType != MLMESCAN_ED || params.m_status != MLMESCAN_SUCCESS)
+    {
+        std::cout
+            << Simulator::Now().As(Time::S)
+            << ": coordinator "
+            << device->GetMac()->GetShortAddress()
+            << " scan failed, ERROR code: "
+            << params.m_status
+            << std::endl
+        ;
+        return;
+    }
+
+    // 2. PAN 수가 가장 적은 채널 중 에너지가 가장 낮은 채널 선택
+    //    m_energyDetList는 스캔한 채널 순서(낮은 채널부터)대로 들어 있음
+    const std::vector<uint32_t>& count = pansPerChannel[panId];
+    uint8_t bestChannel = 0;
+    uint32_t bestCount = std::numeric_limits<uint32_t>::max();
+    uint8_t bestEnergy = std::numeric_limits<uint8_t>::max();
+    uint32_t edIdx = 0;
+    for(uint8_t ch = 11; ch <= 26 && edIdx < params.m_energyDetList.size(); ch++)
+    {
+        if(!(g_scanChannels & (1 << ch)))
+            continue;
+
+        uint8_t energy = params.m_energyDetList[edIdx++];
+        if(count[ch] < bestCount || (count[ch] == bestCount && energy < bestEnergy))
+        {
+            bestChannel = ch;
+            bestCount = count[ch];
+            bestEnergy = energy;
+        }
+    }
+
+    std::cout
+        << Simulator::Now().As(Time::S)
+        << ": coordinator "
+        << device->GetMac()->GetShortAddress()
+        << " selected channel "
+        << +bestChannel
+        << " (PANs: " << bestCount << ", energy: " << +bestEnergy << ")"
+        << ", starting PAN ID "
+        << panId
+        << std::endl
+    ;
+
+    PanState& pan = g_pans[panId];
+    pan.coordinator = device->GetMac()->GetShortAddress();
+    pan.channel = bestChannel;
+
+    // 3. 비콘 미사용 PAN 시작, 디바이스의 비콘 요청에만 비콘으로 응답
+    MlmeStartRequestParams startParams;
+    startParams.m_panCoor = true;
+    startParams.m_PanId = panId;
+    startParams.m_bcnOrd = 15;
+    startParams.m_sfrmOrd = 15;
+    startParams.m_logCh = bestChannel;
+    Simulator::ScheduleNow(&LrWpanMac::MlmeStartRequest, device->GetMac(), startParams);
+    AdvertiseLoad(device, 0);
+}
+
+
+/// @brief 디바이스의 MLME-ASSOCIATE.request에 대한 코디네이터의 MLME-ASSOCIATE.indication 콜백 함수
+/// 모든 PAN에서 짧은 주소가 겹치지 않도록 하나의 카운터에서 주소를 할당합니다.
+/// 연결 응답이 전달되기 전에 다른 디바이스가 같은 PAN으로 몰리지 않도록 부하를 바로 늘려 알립니다.
+/// @param device Ptr<LrWpanNetDevice>
+/// @param params MlmeAssociateIndicationParams
+static void
+MlmeAssociateIndication(Ptr<LrWpanNetDevice> device, MlmeAssociateIndicationParams params)
+{
+    static uint16_t rawAddr = 2;
+
+    MlmeAssociateResponseParams assocRespParams;
+    assocRespParams.m_extDevAddr = params.m_extDevAddr;
+    assocRespParams.m_status = LrWpanAssociationStatus::ASSOCIATED;
+    assocRespParams.m_assocShortAddr = Mac16Address(rawAddr++);
+
+    Simulator::ScheduleNow(&LrWpanMac::MlmeAssociateResponse, device->GetMac(), assocRespParams);
+
+    PanState& pan = g_pans[device->GetMac()->GetPanId()];
+    AdvertiseLoad(device, ++pan.load);
+}
+
+
+/// @brief 코디네이터의 MLME-COMM-STATUS.indication 콜백 함수
+/// 연결 응답을 전달하지 못했으면 늘려 둔 부하를 되돌립니다.
+/// @param device Ptr<LrWpanNetDevice>
+/// @param params MlmeCommStatusIndicationParams
+static void
+CoordinatorCommStatusIndication(Ptr<LrWpanNetDevice> device, MlmeCommStatusIndicationParams params)
+{
+    if(params.m_status == LrWpanMlmeCommStatus::MLMECOMMSTATUS_SUCCESS)
+        return;
+
+    PanState& pan = g_pans[device->GetMac()->GetPanId()];
+    if(pan.load > 0)
+        AdvertiseLoad(device, --pan.load);
+}
+
+
+/// @brief 코디네이터의 MCPS-DATA.indication 콜백 함수, PAN별 수신량을 집계합니다.
+/// @param device Ptr<LrWpanNetDevice>
+/// @param params McpsDataIndicationParams
+/// @param p Ptr<Packet>
+static void
+CoordinatorDataIndication(Ptr<LrWpanNetDevice> device, McpsDataIndicationParams params, Ptr<Packet> p)
+{
+    PanState& pan = g_pans[device->GetMac()->GetPanId()];
+    pan.receivedBytes += p->GetSize();
+    pan.receivedPackets++;
+}
+
+
+/////////////////////////// DEVICE ///////////////////////////
+
+/// @brief 연결된 코디네이터에게 주기적으로 데이터를 보냅니다.
+/// @param device Ptr<LrWpanNetDevice>
+static void
+SendData(Ptr<LrWpanNetDevice> device)
+{
+    static uint8_t msduHandle = 0;
+
+    const DeviceLink& link = g_deviceLinks[device];
+
+    McpsDataRequestParams params;
+    params.m_dstPanId = link.panId;
+    params.m_srcAddrMode = SHORT_ADDR;
+    params.m_dstAddrMode = SHORT_ADDR;
+    params.m_dstAddr = link.coordinator;
+    params.m_msduHandle = msduHandle++;
+    params.m_txOptions = TX_OPTION_ACK;
+
+    device->GetMac()->McpsDataRequest(params, Create<Packet>(g_payloadSize));
+
+    Simulator::Schedule(g_interval, &SendData, device);
+}
+
+
+/// @brief 디바이스의 MLME-BEACON-NOTIFY.indication 콜백 함수, 스캔 중 받은 비콘 페이로드에서 부하를 읽습니다.
+/// @param device Ptr<LrWpanNetDevice>
+/// @param params MlmeBeaconNotifyIndicationParams
+static void
+DeviceBeaconNotify(Ptr<LrWpanNetDevice> device, MlmeBeaconNotifyIndicationParams params)
+{
+    uint8_t payload[BEACON_PAYLOAD_SIZE];
+    if(!params.m_sdu || params.m_sdu->CopyData(payload, BEACON_PAYLOAD_SIZE) < BEACON_PAYLOAD_SIZE)
+        return;
+
+    g_beaconLoads[device][params.m_panDescriptor.m_coorPanId] = (payload[0] << 8) | payload[1];
+}
+
+
+/// @brief 디바이스의 MLME-SCAN.confirm 콜백 함수
+/// 찾은 PAN마다 LQI - loadWeight * 부하 점수를 계산하고 점수가 가장 높은 코디네이터에게 MLME-ASSOCIATE.request를 전송합니다.
+/// 부하는 스캔 중 받은 비콘 페이로드의 값이며, 페이로드가 없던 PAN은 부하 0으로 봅니다.
+/// SHORT_ADDR 모드만 지원함
+/// @param device Ptr<LrWpanNetDevice>
+/// @param params MlmeScanConfirmParams
+static void
+DeviceScanConfirm(Ptr<LrWpanNetDevice> device, MlmeScanConfirmParams params)
+{
+    std::map<uint16_t, uint32_t> loads = std::move(g_beaconLoads[device]);
+    g_beaconLoads.erase(device);
+
+    if(params.m_status != MLMESCAN_SUCCESS || params.m_panDescList.empty())
+    {
+        std::cout
+            << Simulator::Now().As(Time::S)
+            << ": device "
+            << device->GetMac()->GetExtendedAddress()
+            << " BEACON_NOT_FOUND, status: "
+            << params.m_status
+            << std::endl
+        ;
+        return;
+    }
+
+    // 1. LQI와 부하를 함께 고려해 PAN 선택
+    double bestScore = -std::numeric_limits<double>::infinity();
+    uint32_t bestIdx = 0;
+    for(uint32_t i = 0; i < params.m_panDescList.size(); i++)
+    {
+        const PanDescriptor& descriptor = params.m_panDescList[i];
+        double score = descriptor.m_linkQuality - g_loadWeight * loads[descriptor.m_coorPanId];
+        if(score > bestScore)
+        {
+            bestScore = score;
+            bestIdx = i;
+        }
+    }
+    PanDescriptor targetCoordinator = params.m_panDescList[bestIdx];
+
+    DeviceLink& link = g_deviceLinks[device];
+    link.panId = targetCoordinator.m_coorPanId;
+    link.coordinator = targetCoordinator.m_coorShortAddr;
+
+    // 2. 타깃 PAN 코디네이터에 연결 요청(MLME-ASSOCIATE.request)을 보냄
+    MlmeAssociateRequestParams mlmeAssociateRequestParams;
+    mlmeAssociateRequestParams.m_chNum = targetCoordinator.m_logCh;
+    mlmeAssociateRequestParams.m_chPage = targetCoordinator.m_logChPage;
+    mlmeAssociateRequestParams.m_coordPanId = targetCoordinator.m_coorPanId;
+    mlmeAssociateRequestParams.m_capabilityInfo.SetShortAddrAllocOn(true);
+    mlmeAssociateRequestParams.m_coordShortAddr = targetCoordinator.m_coorShortAddr;
+    mlmeAssociateRequestParams.m_coordAddrMode = targetCoordinator.m_coorAddrMode;
+
+    std::cout
+        << Simulator::Now().As(Time::S)
+        << ": device "
+        << device->GetMac()->GetExtendedAddress()
+        << " selected PAN ID "
+        << targetCoordinator.m_coorPanId
+        << " on channel "
+        << +targetCoordinator.m_logCh
+        << " (LQI: " << +targetCoordinator.m_linkQuality
+        << ", advertised load: " << loads[targetCoordinator.m_coorPanId] << ")"
+        << std::endl
+    ;
+
+    Simulator::ScheduleNow(&LrWpanMac::MlmeAssociateRequest, device->GetMac(), mlmeAssociateRequestParams);
+}
+
+
+/// @brief 디바이스의 MLME-ASSOCIATE.confirm 콜백 함수, 연결에 성공하면 데이터 전송을 시작합니다.
+/// @param device Ptr<LrWpanNetDevice>
+/// @param params MlmeAssociateConfirmParams
+static void
+DeviceAssociateConfirm(Ptr<LrWpanNetDevice> device, MlmeAssociateConfirmParams params)
+{
+    if(params.m_status != MLMEASSOC_SUCCESS)
+    {
+        std::cout
+            << Simulator::Now().As(Time::S)
+            << ": device "
+            << device->GetMac()->GetExtendedAddress()
+            << " MLME-ASSOCIATE.confirm ERROR code "
+            << params.m_status
+            << std::endl
+        ;
+        g_deviceLinks.erase(device);
+        return;
+    }
+
+    Ptr<UniformRandomVariable> jitter = CreateObject<UniformRandomVariable>();
+    Simulator::Schedule(Seconds(jitter->GetValue(0, g_interval.GetSeconds())), &SendData, device);
+}
+
+//////////////////////////////////////////////////////////////////
+
+
+int main(int argc, char* argv[])
+{
+    uint32_t coordinatorCount = 4;
+    uint32_t deviceCount = 40;
+    double simTime = 120;
+    double interval = g_interval.GetSeconds();
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("coordinators", "코디네이터 수", coordinatorCount);
+    cmd.AddValue("devices", "디바이스 수", deviceCount);
+    cmd.AddValue("scanChannels", "코디네이터가 탐색하는 채널 비트마스크", g_scanChannels);
+    cmd.AddValue("loadWeight", "PAN 선택 시 디바이스 한 대당 LQI 불이익", g_loadWeight);
+    cmd.AddValue("interval", "디바이스별 데이터 전송 간격 (s)", interval);
+    cmd.AddValue("payload", "MSDU 크기 (byte)", g_payloadSize);
+    cmd.AddValue("simTime", "시뮬레이션 시간 (s)", simTime);
+    cmd.Parse(argc, argv);
+
+    g_interval = Seconds(interval);
+
+    NodeContainer coordinators;
+    NodeContainer devices;
+    coordinators.Create(coordinatorCount);
+    devices.Create(deviceCount);
+
+    // 모든 노드가 서로의 전파 범위 안에 들어오는 좁은 영역에 배치
+    MobilityHelper mobilityHelper;
+    mobilityHelper.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+    mobilityHelper.SetPositionAllocator("ns3::GridPositionAllocator",
+                                        "MinX", DoubleValue(0.0),
+                                        "MinY", DoubleValue(0.0),
+                                        "DeltaX", DoubleValue(5.0),
+                                        "DeltaY", DoubleValue(5.0),
+                                        "GridWidth", UintegerValue(8),
+                                        "LayoutType", StringValue("RowFirst"));
+    mobilityHelper.Install(coordinators);
+    mobilityHelper.Install(devices);
+
+    LrWpanHelper lrWpanHelper;
+    NetDeviceContainer coordinatorDevices = lrWpanHelper.Install(coordinators);
+    NetDeviceContainer deviceDevices = lrWpanHelper.Install(devices);
+
+    // 코디네이터: 앞선 코디네이터가 PAN을 시작한 뒤 스캔하도록 순서대로 부팅
+    // ACTIVE + ED 스캔에 걸리는 시간보다 넉넉하게 간격을 둠
+    Time bootInterval = Seconds(6);
+    for(uint32_t i = 0; i < coordinatorDevices.GetN(); i++)
+    {
+        Ptr<LrWpanNetDevice> netDevice = DynamicCast<LrWpanNetDevice>(coordinatorDevices.Get(i));
+        uint16_t panId = i + 1;
+
+        netDevice->GetMac()->SetShortAddress(Mac16Address(0xCA00 + i));
+        netDevice->GetMac()->SetMlmeScanConfirmCallback(
+            MakeBoundCallback(&CoordinatorScanConfirm, netDevice, panId));
+        netDevice->GetMac()->SetMlmeAssociateIndicationCallback(
+            MakeBoundCallback(&MlmeAssociateIndication, netDevice));
+        netDevice->GetMac()->SetMcpsDataIndicationCallback(
+            MakeBoundCallback(&CoordinatorDataIndication, netDevice));
+        netDevice->GetMac()->SetMlmeCommStatusIndicationCallback(
+            MakeBoundCallback(&CoordinatorCommStatusIndication, netDevice));
+
+        MlmeScanRequestParams scanParams;
+        scanParams.m_chPage = 0;
+        scanParams.m_scanChannels = g_scanChannels;
+        scanParams.m_scanDuration = g_scanDuration;
+        scanParams.m_scanType = MLMESCAN_ACTIVE;
+        Simulator::ScheduleWithContext(coordinators.Get(i)->GetId(),
+                                       Seconds(1) + bootInterval * i,
+                                       &LrWpanMac::MlmeScanRequest,
+                                       netDevice->GetMac(),
+                                       scanParams);
+    }
+
+    // 디바이스: 모든 PAN이 시작된 뒤 100 ms 간격으로 스캔 시작
+    Time deviceStart = Seconds(1) + bootInterval * coordinatorCount;
+    for(uint32_t i = 0; i < deviceDevices.GetN(); i++)
+    {
+        Ptr<LrWpanNetDevice> netDevice = DynamicCast<LrWpanNetDevice>(deviceDevices.Get(i));
+
+        netDevice->GetMac()->SetMlmeScanConfirmCallback(
+            MakeBoundCallback(&DeviceScanConfirm, netDevice));
+        netDevice->GetMac()->SetMlmeAssociateConfirmCallback(
+            MakeBoundCallback(&DeviceAssociateConfirm, netDevice));
+        netDevice->GetMac()->SetMlmeBeaconNotifyIndicationCallback(
+            MakeBoundCallback(&DeviceBeaconNotify, netDevice));
+
+        MlmeScanRequestParams scanParams;
+        scanParams.m_chPage = 0;
+        scanParams.m_scanChannels = g_scanChannels;
+        scanParams.m_scanDuration = g_scanDuration;
+        scanParams.m_scanType = MLMESCAN_ACTIVE;
+        Simulator::ScheduleWithContext(devices.Get(i)->GetId(),
+                                       deviceStart + MilliSeconds(i * 100),
+                                       &LrWpanMac::MlmeScanRequest,
+                                       netDevice->GetMac(),
+                                       scanParams);
+    }
+
+    // 처리량은 모든 디바이스가 연결을 시도한 뒤부터 계산
+    Time measureStart = deviceStart + MilliSeconds(deviceCount * 100) + Seconds(10);
+    Simulator::Schedule(measureStart, []() {
+        for(auto& entry : g_pans)
+        {
+            entry.second.receivedBytes = 0;
+            entry.second.receivedPackets = 0;
+        }
+    });
+
+    Simulator::Stop(Seconds(simTime) + measureStart);
+    Simulator::Run();
+
+    // PAN별 / 전체 처리량 출력
+    double measureSeconds = simTime;
+    uint64_t totalBytes = 0;
+    for(const auto& entry : g_pans)
+    {
+        const PanState& pan = entry.second;
+        totalBytes += pan.receivedBytes;
+        std::cout
+            << "PAN " << entry.first
+            << " coordinator " << pan.coordinator
+            << " channel " << +pan.channel
+            << ": " << pan.load << " devices, "
+            << pan.receivedPackets << " packets, "
+            << pan.receivedBytes * 8 / measureSeconds / 1e3 << " kbit/s"
+            << std::endl
+        ;
+    }
+    std::cout
+        << "aggregate throughput: "
+        << totalBytes * 8 / measureSeconds / 1e3
+        << " kbit/s over " << g_pans.size() << " PANs"
+        << std::endl
+    ;
+
+    Simulator::Destroy();
+
+    return 0;
+}
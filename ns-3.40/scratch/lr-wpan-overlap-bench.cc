@@ -0,0 +1,195 @@
+/*
+ * 겹치는 전송 수에 따른 PHY 수신 비용 측정
+ *
+ * lr-wpan-csmaca.cc처럼 여러 디바이스가 코디네이터(00:01)에게 동시에 보내는 상황을
+ * 겹치는 전송 수 k를 늘려 가며 반복합니다. lr-wpan-test.cc와 같이 macMinBE = 0,
+ * macMaxCSMABackoffs = 0으로 두어 매 라운드 k개의 프레임이 거의 같은 시각에 채널에 올라갑니다.
+ *
+ * LrWpanPhy의 간섭 계산(LrWpanInterferenceHelper)은 신호가 시작 / 끝날 때 합계 PSD에 더하고 빼는
+ * 방식으로 갱신되고, SINR / PER은 그 변경 시점마다 구간 단위로 평가됩니다. 따라서 신호 도착 하나당
+ * 비용은 k와 무관해야 하며, 이 프로그램은 k별로 "신호 도착(전송 x 수신기) 하나당 wall-clock 시간"을
+ * 출력해 이를 확인합니다.
+ *
+ * 사용 예:
+ *   ./ns3 run "lr-wpan-overlap-bench --overlaps=1,2,4,8,16,32,64 --rounds=2000"
+ */
+#include <ns3/core-module.h>
+#include <ns3/lr-wpan-module.h>
+#include <ns3/mobility-module.h>
+#include <ns3/network-module.h>
+#include <ns3/simulator.h>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+using namespace ns3;
+
+const int COORDINATOR_PAN_ID = 5;
+
+
+/// @brief 실행 한 번의 측정 결과
+struct OverlapResult
+{
+    uint64_t txFrames = 0;
+    uint64_t rxEnd = 0;         ///< PHY가 끝까지 수신한 프레임 수
+    uint64_t delivered = 0;     ///< 코디네이터가 받은 프레임 수
+    double wallSeconds = 0;
+};
+
+static OverlapResult g_result;
+
+
+static void
+PhyTxBegin(Ptr<const Packet> p)
+{
+    g_result.txFrames++;
+}
+
+
+static void
+PhyRxEnd(Ptr<const Packet> p, double sinr)
+{
+    g_result.rxEnd++;
+}
+
+
+static void
+McpsDataIndication(McpsDataIndicationParams params, Ptr<Packet> p)
+{
+    g_result.delivered++;
+}
+
+
+/// @brief 한 라운드: 모든 디바이스가 같은 시각에 코디네이터에게 전송을 요청합니다.
+/// @param macs 디바이스 MAC 목록
+/// @param roundsLeft 남은 라운드 수
+/// @param period 라운드 간격
+static void
+SendRound(std::vector<Ptr<LrWpanMac>> macs, uint32_t roundsLeft, Time period)
+{
+    static uint8_t msduHandle = 0;
+
+    for(const Ptr<LrWpanMac>& mac : macs)
+    {
+        McpsDataRequestParams params;
+        params.m_dstPanId = COORDINATOR_PAN_ID;
+        params.m_srcAddrMode = SHORT_ADDR;
+        params.m_dstAddrMode = SHORT_ADDR;
+        params.m_dstAddr = Mac16Address("00:01");
+        params.m_msduHandle = msduHandle++;
+        params.m_txOptions = TX_OPTION_NONE;
+
+        mac->McpsDataRequest(params, Create<Packet>(20));
+    }
+
+    if(roundsLeft > 1)
+        Simulator::Schedule(period, &SendRound, macs, roundsLeft - 1, period);
+}
+
+
+/// @brief 디바이스 k개가 매 라운드 동시에 전송하는 PAN을 실행합니다.
+/// @param overlap 동시에 전송하는 디바이스 수
+/// @param rounds 라운드 수
+/// @return 측정 결과
+static OverlapResult
+RunOverlap(uint32_t overlap, uint32_t rounds)
+{
+    g_result = OverlapResult();
+
+    NodeContainer pan;
+    pan.Create(overlap + 1);
+
+    // 모든 노드가 서로의 전파 범위 안에 있도록 배치
+    MobilityHelper mobilityHelper;
+    mobilityHelper.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+    mobilityHelper.SetPositionAllocator("ns3::UniformDiscPositionAllocator",
+                                        "rho", DoubleValue(10.0));
+    mobilityHelper.Install(pan);
+
+    LrWpanHelper lrWpanHelper;
+    NetDeviceContainer netDevices = lrWpanHelper.Install(pan);
+    lrWpanHelper.CreateAssociatedPan(netDevices, COORDINATOR_PAN_ID);
+
+    std::vector<Ptr<LrWpanMac>> macs;
+    for(uint32_t i = 0; i < netDevices.GetN(); i++)
+    {
+        Ptr<LrWpanNetDevice> netDevice = DynamicCast<LrWpanNetDevice>(netDevices.Get(i));
+        netDevice->GetPhy()->TraceConnectWithoutContext("PhyTxBegin", MakeCallback(&PhyTxBegin));
+        netDevice->GetPhy()->TraceConnectWithoutContext("PhyRxEnd", MakeCallback(&PhyRxEnd));
+
+        if(i == 0)
+        {
+            netDevice->GetMac()->SetMcpsDataIndicationCallback(MakeCallback(&McpsDataIndication));
+            continue;
+        }
+
+        Ptr<LrWpanCsmaCa> csmaCa = netDevice->GetCsmaCa();
+        csmaCa->SetMacMinBE(0);
+        csmaCa->SetMacMaxCSMABackoffs(0);
+        macs.push_back(netDevice->GetMac());
+    }
+
+    // 프레임(약 1.3 ms)과 CSMA-CA가 끝날 만큼 라운드 간격을 둠
+    Time period = MilliSeconds(10);
+    Simulator::Schedule(Seconds(0.1), &SendRound, macs, rounds, period);
+    Simulator::Stop(Seconds(0.2) + period * rounds);
+
+    auto wallStart = std::chrono::steady_clock::now();
+    Simulator::Run();
+    g_result.wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+
+    Simulator::Destroy();
+    return g_result;
+}
+
+
+int main(int argc, char* argv[])
+{
+    std::string overlaps = "1,2,4,8,16,32";
+    uint32_t rounds = 1000;
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("overlaps", "쉼표로 구분한 동시 전송 수 목록", overlaps);
+    cmd.AddValue("rounds", "라운드 수", rounds);
+    cmd.Parse(argc, argv);
+
+    std::cout
+        << std::left
+        << std::setw(6) << "k"
+        << std::setw(12) << "tx"
+        << std::setw(14) << "arrivals"
+        << std::setw(12) << "rx end"
+        << std::setw(12) << "delivered"
+        << std::setw(10) << "wall(s)"
+        << "ns/arrival"
+        << std::endl
+    ;
+
+    std::stringstream ss(overlaps);
+    std::string item;
+    while(std::getline(ss, item, ','))
+    {
+        uint32_t k = std::stoul(item);
+        OverlapResult result = RunOverlap(k, rounds);
+
+        // 신호 도착 수: 전송마다 송신자를 제외한 모든 노드에 도착
+        uint64_t arrivals = result.txFrames * k;
+
+        std::cout
+            << std::left
+            << std::setw(6) << k
+            << std::setw(12) << result.txFrames
+            << std::setw(14) << arrivals
+            << std::setw(12) << result.rxEnd
+            << std::setw(12) << result.delivered
+            << std::setw(10) << std::fixed << std::setprecision(3) << result.wallSeconds
+            << std::setprecision(1) << (arrivals ? result.wallSeconds * 1e9 / arrivals : 0)
+            << std::endl
+        ;
+    }
+
+    return 0;
+}
@@ -0,0 +1,241 @@
+#include "lr-wpan-scenario.h"
+
+#include <ns3/abort.h>
+#include <ns3/header.h>
+#include <ns3/simulator.h>
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <utility>
+
+using namespace ns3;
+
+namespace
+{
+
+/// @brief 핸들까지 풀어 둔 요청, 이벤트 안에서는 캐스트 없이 바로 호출합니다.
+struct PreparedRequest
+{
+    Ptr<LrWpanMac> mac;
+    McpsDataRequestParams params;
+    Ptr<Packet> packet;
+};
+
+using PreparedBatch = std::vector<PreparedRequest>;
+
+
+/// @brief 같은 시각 / 같은 노드의 요청을 제출 순서대로 MAC에 넘깁니다.
+void
+RunBatch(std::shared_ptr<PreparedBatch> batch)
+{
+    for(PreparedRequest& request : *batch)
+        request.mac->McpsDataRequest(request.params, request.packet);
+}
+
+
+/// @brief 풀 패킷에 페이로드를 제자리에서 써 넣기 위한 쓰기 전용 헤더
+///
+/// Packet에는 원시 바이트를 덮어쓰는 API가 없고 AddAtEnd(Ptr<Packet>)는 패킷을 새로 만들어야 하므로,
+/// 비운 버퍼의 앞쪽 여유 공간에 AddHeader()로 씁니다.
+class PooledPayload : public Header
+{
+  public:
+    PooledPayload(const uint8_t* data, uint32_t size)
+        : m_data(data),
+          m_size(size)
+    {
+    }
+
+    static TypeId GetTypeId()
+    {
+        static TypeId tid = TypeId("ns3::LrWpanPooledPayload").SetParent<Header>().SetGroupName("LrWpan");
+        return tid;
+    }
+
+    TypeId GetInstanceTypeId() const override
+    {
+        return GetTypeId();
+    }
+
+    void Print(std::ostream& os) const override
+    {
+        os << "size=" << m_size;
+    }
+
+    uint32_t GetSerializedSize() const override
+    {
+        return m_size;
+    }
+
+    void Serialize(Buffer::Iterator start) const override
+    {
+        start.Write(m_data, m_size);
+    }
+
+    uint32_t Deserialize(Buffer::Iterator start) override
+    {
+        // 쓰기 전용
+        return 0;
+    }
+
+  private:
+    const uint8_t* m_data;
+    uint32_t m_size;
+};
+
+} // namespace
+
+
+LrWpanPacketPool::LrWpanPacketPool(uint32_t capacity)
+    : m_capacity(capacity)
+{
+    m_packets.reserve(capacity);
+}
+
+
+Ptr<Packet>
+LrWpanPacketPool::Acquire(const uint8_t* data, uint32_t size)
+{
+    // 참조 수가 1이면 MAC / PHY / 채널이 모두 놓은 패킷
+    for(uint32_t n = 0; n < m_packets.size(); n++)
+    {
+        Ptr<Packet>& packet = m_packets[m_next];
+        m_next = (m_next + 1) % m_packets.size();
+        if(packet->GetReferenceCount() != 1)
+            continue;
+
+        // 트레일러를 먼저 떼고 나머지를 앞에서부터 비우면 버퍼의 시작 위치가 이전 페이로드의 끝에 남아,
+        // 새 페이로드와 MAC 헤더는 앞쪽에, 트레일러는 뒤쪽에 재할당 없이 들어갑니다.
+        packet->RemoveAtEnd(std::min(packet->GetSize(), LrWpanMacTrailer().GetSerializedSize()));
+        packet->RemoveAtStart(packet->GetSize());
+        packet->RemoveAllPacketTags();
+        packet->RemoveAllByteTags();
+        packet->AddHeader(PooledPayload(data, size));
+        m_reused++;
+        return packet;
+    }
+
+    Ptr<Packet> packet = Create<Packet>(data, size);
+    if(m_packets.size() < m_capacity)
+    {
+        m_packets.push_back(packet);
+        m_created++;
+    }
+    else
+        m_overflow++;
+
+    return packet;
+}
+
+
+LrWpanDeviceTable::LrWpanDeviceTable(const NetDeviceContainer& devices)
+{
+    m_handles.reserve(devices.GetN());
+    for(uint32_t i = 0; i < devices.GetN(); i++)
+        Add(devices.Get(i));
+}
+
+
+uint32_t
+LrWpanDeviceTable::Add(Ptr<NetDevice> device)
+{
+    Ptr<LrWpanNetDevice> lrWpanDevice = DynamicCast<LrWpanNetDevice>(device);
+    NS_ABORT_MSG_IF(!lrWpanDevice, "device " << device << " is not an LrWpanNetDevice");
+
+    LrWpanHandles handles;
+    handles.device = lrWpanDevice;
+    handles.mac = lrWpanDevice->GetMac();
+    handles.phy = lrWpanDevice->GetPhy();
+    handles.csmaCa = lrWpanDevice->GetCsmaCa();
+    handles.nodeId = lrWpanDevice->GetNode() ? lrWpanDevice->GetNode()->GetId() : 0;
+    handles.packetPool = std::make_shared<LrWpanPacketPool>();
+    m_handles.push_back(handles);
+
+    return m_handles.size() - 1;
+}
+
+
+McpsDataRequestParams
+CreateMcpsDataRequestParams(Mac16Address dstAddr, int dstPanId, LrWpanAddressMode addrMode, uint8_t txOption)
+{
+    static uint8_t msduHandle = 0;
+
+    McpsDataRequestParams params;
+    params.m_dstAddrMode = params.m_srcAddrMode = addrMode;
+    params.m_dstAddr = dstAddr;
+    if(dstPanId >= 0)
+        params.m_dstPanId = dstPanId;
+    params.m_txOptions = txOption;
+    params.m_msduHandle = msduHandle++;
+
+    return params;
+}
+
+
+Ptr<Packet>
+CreateMessagePacket(const std::string& message)
+{
+    return Create<Packet>(reinterpret_cast<const uint8_t*>(message.data()), message.length());
+}
+
+
+void
+SubmitMcpsDataRequests(const LrWpanDeviceTable& table, std::vector<McpsDataSubmission>& batch)
+{
+    // 같은 (지연, 노드)의 요청을 묶음 하나로 모음. 묶음은 처음 나타난 순서대로, 묶음 안에서는 제출 순서대로
+    std::map<std::pair<Time, uint32_t>, size_t> groupIndex;
+    std::vector<std::pair<const McpsDataSubmission*, std::shared_ptr<PreparedBatch>>> groups;
+    for(const McpsDataSubmission& submission : batch)
+    {
+        const LrWpanHandles& handles = table[submission.device];
+        auto it = groupIndex.emplace(std::make_pair(submission.delay, handles.nodeId), groups.size()).first;
+        if(it->second == groups.size())
+            groups.emplace_back(&submission, std::make_shared<PreparedBatch>());
+        groups[it->second].second->push_back({handles.mac, submission.params, submission.packet});
+    }
+
+    // 같은 시각의 이벤트는 예약 순서대로 실행되므로 묶음 순서가 곧 실행 순서
+    for(const auto& group : groups)
+        Simulator::ScheduleWithContext(table[group.first->device].nodeId, group.first->delay, &RunBatch, group.second);
+
+    batch.clear();
+}
+
+
+McpsDataFlow::McpsDataFlow(const LrWpanHandles& source, const McpsDataRequestParams& params)
+    : m_mac(source.mac),
+      m_pool(source.packetPool),
+      m_params(params)
+{
+}
+
+
+McpsDataRequestParams
+McpsDataFlow::NextParams()
+{
+    McpsDataRequestParams params = m_params;
+    m_params.m_msduHandle++;
+    return params;
+}
+
+
+Ptr<Packet>
+McpsDataFlow::AcquirePacket(const uint8_t* data, uint32_t size)
+{
+    return m_pool->Acquire(data, size);
+}
+
+
+void
+McpsDataFlow::Send(const uint8_t* data, uint32_t size)
+{
+    m_mac->McpsDataRequest(NextParams(), AcquirePacket(data, size));
+}
+
+
+void
+McpsDataFlow::Send(const std::string& message)
+{
+    Send(reinterpret_cast<const uint8_t*>(message.data()), message.length());
+}
@@ -0,0 +1,200 @@
+#ifndef LR_WPAN_SCENARIO_H
+#define LR_WPAN_SCENARIO_H
+
+#include <ns3/lr-wpan-module.h>
+#include <ns3/network-module.h>
+#include <ns3/nstime.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/*
+ * 스크래치 시나리오 공용 라이브러리
+ *
+ * 시나리오마다 복사해 쓰던 getLrWpanDevice / SetMcpsDataRequest / createMcpsDataRequestParams를
+ * 한곳에 모읍니다.
+ *  - LrWpanDeviceTable: NetDeviceContainer를 한 번만 DynamicCast해 노드별 LrWpanNetDevice / LrWpanMac /
+ *    LrWpanPhy / LrWpanCsmaCa 핸들을 연속된 배열에 캐시합니다. 이후에는 인덱스로 바로 꺼내 쓰므로
+ *    메시지를 보낼 때마다 Node::GetDevice()와 DynamicCast를 거치지 않습니다.
+ *  - SubmitMcpsDataRequests: 여러 MCPS-DATA.request를 한 번에 제출합니다. 같은 시각 / 같은 노드의 요청은
+ *    이벤트 하나로 묶어 해당 노드의 context로 실행합니다. 묶음끼리는 처음 제출된 순서를 유지하므로
+ *    같은 시각의 요청이 하나씩 예약할 때와 같은 순서로 실행됩니다.
+ *  - LrWpanPacketPool / McpsDataFlow: 송신 fast path. 디바이스별 풀에서 전송이 끝난 패킷 버퍼를 다시 쓰고,
+ *    주소 / PAN ID / 주소 모드가 고정된 흐름은 params 템플릿에서 msduHandle만 바꿔 보냅니다.
+ *  - LrWpanTxQueue(lr-wpan-tx-queue.h): MAC 앞단의 크기 제한 송신 큐
+ *
+ * scratch/CMakeLists.txt가 이 디렉터리를 라이브러리로 빌드해 모든 스크래치에 링크합니다.
+ */
+
+
+/// @brief 디바이스 하나의 송신 패킷 풀
+///
+/// LrWpanMac::McpsDataRequest()는 넘겨받은 패킷에 MAC 헤더 / 트레일러를 직접 붙이고, 전송이 끝나면
+/// MAC / PHY / 채널이 잡고 있던 참조를 모두 놓습니다. 풀은 참조 수가 1(풀 자신)로 돌아온 패킷만 골라
+/// 내용을 비우고 새 페이로드를 써 넣으므로, Packet 객체와 버퍼(헤더 / 트레일러 여유 공간 포함)를
+/// 다시 할당하지 않습니다. 다시 쓴 패킷은 이전 패킷과 UID가 같습니다.
+class LrWpanPacketPool
+{
+  public:
+    /// @param capacity 풀에 보관할 최대 패킷 수, 모두 사용 중이면 풀 밖의 패킷을 새로 만듭니다.
+    explicit LrWpanPacketPool(uint32_t capacity = 16);
+
+    /// @brief 페이로드를 담은 패킷을 꺼냅니다.
+    /// @param data 페이로드
+    /// @param size 페이로드 길이
+    ns3::Ptr<ns3::Packet> Acquire(const uint8_t* data, uint32_t size);
+
+    uint32_t GetCapacity() const
+    {
+        return m_capacity;
+    }
+
+    /// @brief 풀에 넣기 위해 새로 만든 패킷 수
+    uint64_t GetCreated() const
+    {
+        return m_created;
+    }
+
+    /// @brief 다시 쓴 패킷 수
+    uint64_t GetReused() const
+    {
+        return m_reused;
+    }
+
+    /// @brief 풀이 가득 차 풀 밖에서 만든 패킷 수
+    uint64_t GetOverflow() const
+    {
+        return m_overflow;
+    }
+
+  private:
+    std::vector<ns3::Ptr<ns3::Packet>> m_packets;
+    uint32_t m_capacity;
+    uint32_t m_next = 0;        ///< 다음에 확인할 슬롯, 라운드 로빈
+    uint64_t m_created = 0;
+    uint64_t m_reused = 0;
+    uint64_t m_overflow = 0;
+};
+
+
+/// @brief 노드 하나의 LR-WPAN 핸들
+struct LrWpanHandles
+{
+    ns3::Ptr<ns3::LrWpanNetDevice> device;
+    ns3::Ptr<ns3::LrWpanMac> mac;
+    ns3::Ptr<ns3::LrWpanPhy> phy;
+    ns3::Ptr<ns3::LrWpanCsmaCa> csmaCa;
+    uint32_t nodeId = 0;
+    std::shared_ptr<LrWpanPacketPool> packetPool;  ///< 디바이스의 송신 패킷 풀
+};
+
+
+/// @brief 노드별 LR-WPAN 핸들 테이블, 인덱스는 NetDeviceContainer의 순서와 같습니다.
+class LrWpanDeviceTable
+{
+  public:
+    LrWpanDeviceTable() = default;
+
+    /// @brief 컨테이너의 모든 디바이스를 LrWpanNetDevice로 변환해 핸들을 캐시합니다.
+    /// LrWpanNetDevice가 아닌 디바이스가 있으면 프로그램을 종료합니다.
+    /// @param devices LrWpanHelper::Install()의 결과
+    explicit LrWpanDeviceTable(const ns3::NetDeviceContainer& devices);
+
+    /// @brief 디바이스 하나를 추가합니다.
+    /// @return 추가된 디바이스의 인덱스
+    uint32_t Add(ns3::Ptr<ns3::NetDevice> device);
+
+    uint32_t GetN() const
+    {
+        return m_handles.size();
+    }
+
+    const LrWpanHandles& Get(uint32_t index) const
+    {
+        return m_handles[index];
+    }
+
+    const LrWpanHandles& operator[](uint32_t index) const
+    {
+        return m_handles[index];
+    }
+
+    std::vector<LrWpanHandles>::const_iterator begin() const
+    {
+        return m_handles.begin();
+    }
+
+    std::vector<LrWpanHandles>::const_iterator end() const
+    {
+        return m_handles.end();
+    }
+
+  private:
+    std::vector<LrWpanHandles> m_handles;
+};
+
+
+/// @brief SubmitMcpsDataRequests()로 제출할 요청 하나
+struct McpsDataSubmission
+{
+    uint32_t device;                        ///< LrWpanDeviceTable 인덱스
+    ns3::McpsDataRequestParams params;
+    ns3::Ptr<ns3::Packet> packet;
+    ns3::Time delay;                        ///< 현재 시각 기준 지연
+};
+
+
+/// @brief MCPS-DATA.request params 구조체를 만듭니다. msduHandle은 호출마다 1씩 증가합니다.
+/// @param dstAddr 목적지 MAC 주소
+/// @param dstPanId 목적지 PAN ID, 음수이면 설정하지 않음
+/// @param addrMode LrWpanAddressMode
+/// @param txOption TX_OPTION_ACK, TX_OPTION_NONE: TX_OPTION_GTS, TX_OPTION_INDIRECT는 현재 미지원
+/// @return McpsDataRequestParams
+ns3::McpsDataRequestParams CreateMcpsDataRequestParams(ns3::Mac16Address dstAddr,
+                                                       int dstPanId,
+                                                       ns3::LrWpanAddressMode addrMode,
+                                                       uint8_t txOption);
+
+/// @brief 문자열을 담은 패킷을 만듭니다.
+ns3::Ptr<ns3::Packet> CreateMessagePacket(const std::string& message);
+
+/// @brief 여러 MCPS-DATA.request를 한 번에 예약합니다.
+/// 같은 지연 / 같은 노드의 요청은 제출 순서대로 이벤트 하나에서 LrWpanMac::McpsDataRequest()를 호출합니다.
+/// 이벤트는 각 묶음의 첫 요청이 제출된 순서대로 예약되므로, 같은 지연의 다른 노드 요청끼리 순서가 바뀌지 않습니다.
+/// @param table 핸들 테이블
+/// @param batch 제출할 요청, 호출 후 비워집니다.
+void SubmitMcpsDataRequests(const LrWpanDeviceTable& table, std::vector<McpsDataSubmission>& batch);
+
+
+
+/// @brief 목적지 / PAN ID / 주소 모드 / TX 옵션이 고정된 송신 흐름
+///
+/// params는 생성할 때 한 번만 만들어 두고 보낼 때마다 msduHandle만 바꿉니다.
+/// 패킷은 송신 디바이스의 LrWpanPacketPool에서 꺼냅니다.
+class McpsDataFlow
+{
+  public:
+    /// @param source 송신 디바이스 핸들
+    /// @param params 템플릿, m_msduHandle은 첫 프레임의 handle
+    McpsDataFlow(const LrWpanHandles& source, const ns3::McpsDataRequestParams& params);
+
+    /// @brief 다음 프레임의 params, msduHandle이 1씩 증가합니다.
+    ns3::McpsDataRequestParams NextParams();
+
+    /// @brief 송신 디바이스의 풀에서 패킷을 꺼냅니다.
+    ns3::Ptr<ns3::Packet> AcquirePacket(const uint8_t* data, uint32_t size);
+
+    /// @brief 지금 바로 LrWpanMac::McpsDataRequest()를 호출합니다.
+    void Send(const uint8_t* data, uint32_t size);
+
+    void Send(const std::string& message);
+
+  private:
+    ns3::Ptr<ns3::LrWpanMac> m_mac;
+    std::shared_ptr<LrWpanPacketPool> m_pool;
+    ns3::McpsDataRequestParams m_params;
+};
+
+#endif /* LR_WPAN_SCENARIO_H */
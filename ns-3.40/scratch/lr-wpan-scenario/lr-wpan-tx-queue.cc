@@ -0,0 +1,228 @@
+#include "lr-wpan-tx-queue.h"
+
+#include <ns3/abort.h>
+#include <ns3/enum.h>
+#include <ns3/log.h>
+#include <ns3/simulator.h>
+#include <ns3/uinteger.h>
+
+#include <algorithm>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("LrWpanTxQueue");
+
+NS_OBJECT_ENSURE_REGISTERED(LrWpanTxQueue);
+
+
+TypeId
+LrWpanTxQueue::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::LrWpanTxQueue")
+            .SetParent<Object>()
+            .SetGroupName("LrWpan")
+            .AddConstructor<LrWpanTxQueue>()
+            .AddAttribute("MaxSize",
+                          "Maximum number of requests held in the queue",
+                          UintegerValue(16),
+                          MakeUintegerAccessor(&LrWpanTxQueue::m_maxSize),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("DropPolicy",
+                          "Policy applied when the queue is full",
+                          EnumValue(LrWpanTxQueue::DROP_TAIL),
+                          MakeEnumAccessor(&LrWpanTxQueue::m_policy),
+                          MakeEnumChecker(LrWpanTxQueue::DROP_TAIL, "DropTail",
+                                          LrWpanTxQueue::DROP_OLDEST, "DropOldest",
+                                          LrWpanTxQueue::PRIORITY, "Priority"))
+            .AddAttribute("MaxDelay",
+                          "Requests waiting longer than this are dropped before reaching the MAC, "
+                          "zero to disable",
+                          TimeValue(Seconds(0)),
+                          MakeTimeAccessor(&LrWpanTxQueue::m_maxDelay),
+                          MakeTimeChecker())
+            .AddTraceSource("Enqueue",
+                            "A request entered the queue",
+                            MakeTraceSourceAccessor(&LrWpanTxQueue::m_enqueueTrace),
+                            "ns3::Packet::TracedCallback")
+            .AddTraceSource("Dequeue",
+                            "A request left the queue for the MAC, with its sojourn time",
+                            MakeTraceSourceAccessor(&LrWpanTxQueue::m_dequeueTrace),
+                            "ns3::LrWpanTxQueue::SojournTracedCallback")
+            .AddTraceSource("Drop",
+                            "A request was dropped by the queue",
+                            MakeTraceSourceAccessor(&LrWpanTxQueue::m_dropTrace),
+                            "ns3::LrWpanTxQueue::DropTracedCallback");
+    return tid;
+}
+
+
+LrWpanTxQueue::LrWpanTxQueue()
+    : m_maxSize(16),
+      m_policy(DROP_TAIL),
+      m_busy(false),
+      m_dropped(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+
+LrWpanTxQueue::~LrWpanTxQueue()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+
+void
+LrWpanTxQueue::DoDispose()
+{
+    m_items.clear();
+    m_mac = nullptr;
+    m_confirmCallback = MakeNullCallback<void, McpsDataConfirmParams>();
+    Object::DoDispose();
+}
+
+
+void
+LrWpanTxQueue::Install(const LrWpanHandles& handles)
+{
+    m_mac = handles.mac;
+    m_mac->SetMcpsDataConfirmCallback(MakeCallback(&LrWpanTxQueue::McpsDataConfirm, this));
+}
+
+
+void
+LrWpanTxQueue::SetMcpsDataConfirmCallback(McpsDataConfirmCallback callback)
+{
+    m_confirmCallback = callback;
+}
+
+
+bool
+LrWpanTxQueue::Enqueue(const McpsDataRequestParams& params, Ptr<Packet> packet, uint32_t messageId)
+{
+    NS_ABORT_MSG_IF(!m_mac, "LrWpanTxQueue::Install() was not called");
+
+    DropExpired();
+
+    if(m_items.size() >= m_maxSize)
+    {
+        switch(m_policy)
+        {
+            case DROP_TAIL:
+                m_dropped++;
+                m_dropTrace(packet, DROP_OVERFLOW);
+                return false;
+
+            case DROP_OLDEST:
+                Drop(m_items.begin(), DROP_OVERFLOW);
+                break;
+
+            case PRIORITY: {
+                // ID가 가장 큰 요청 중 가장 늦게 들어온 것
+                auto victim = m_items.begin();
+                for(auto it = m_items.begin(); it != m_items.end(); it++)
+                {
+                    if(it->messageId >= victim->messageId)
+                        victim = it;
+                }
+
+                if(messageId >= victim->messageId)
+                {
+                    m_dropped++;
+                    m_dropTrace(packet, DROP_OVERFLOW);
+                    return false;
+                }
+                Drop(victim, DROP_OVERFLOW);
+                break;
+            }
+        }
+    }
+
+    m_items.push_back({params, packet, messageId, Simulator::Now()});
+    m_enqueueTrace(packet);
+
+    Transmit();
+    return true;
+}
+
+
+void
+LrWpanTxQueue::DropExpired()
+{
+    if(m_maxDelay.IsZero())
+        return;
+
+    Time now = Simulator::Now();
+    for(auto it = m_items.begin(); it != m_items.end();)
+    {
+        if(now - it->enqueueTime > m_maxDelay)
+        {
+            m_dropped++;
+            m_dropTrace(it->packet, DROP_EXPIRED);
+            it = m_items.erase(it);
+        }
+        else
+            it++;
+    }
+}
+
+
+void
+LrWpanTxQueue::Drop(std::deque<Item>::iterator item, DropReason reason)
+{
+    m_dropped++;
+    m_dropTrace(item->packet, reason);
+    m_items.erase(item);
+}
+
+
+std::deque<LrWpanTxQueue::Item>::iterator
+LrWpanTxQueue::Next()
+{
+    if(m_policy != PRIORITY)
+        return m_items.begin();
+
+    // ID가 같으면 먼저 들어온 요청
+    return std::min_element(m_items.begin(), m_items.end(), [](const Item& a, const Item& b) {
+        return a.messageId < b.messageId;
+    });
+}
+
+
+void
+LrWpanTxQueue::Transmit()
+{
+    if(m_busy)
+        return;
+
+    DropExpired();
+    if(m_items.empty())
+        return;
+
+    auto next = Next();
+    Item item = *next;
+    m_items.erase(next);
+
+    m_busy = true;
+    m_dequeueTrace(item.packet, Simulator::Now() - item.enqueueTime);
+    m_mac->McpsDataRequest(item.params, item.packet);
+}
+
+
+void
+LrWpanTxQueue::McpsDataConfirm(McpsDataConfirmParams params)
+{
+    NS_LOG_FUNCTION(this << params.m_status);
+
+    m_busy = false;
+    if(!m_confirmCallback.IsNull())
+        m_confirmCallback(params);
+
+    // MAC이 McpsDataRequest() 안에서 바로 confirm하는 경우가 있어 재귀 대신 다음 이벤트로 넘김
+    if(!m_items.empty())
+        Simulator::ScheduleNow(&LrWpanTxQueue::Transmit, this);
+}
+
+} // namespace ns3
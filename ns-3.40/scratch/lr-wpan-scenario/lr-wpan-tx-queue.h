@@ -0,0 +1,132 @@
+#ifndef LR_WPAN_TX_QUEUE_H
+#define LR_WPAN_TX_QUEUE_H
+
+#include "lr-wpan-scenario.h"
+
+#include <ns3/lr-wpan-module.h>
+#include <ns3/nstime.h>
+#include <ns3/object.h>
+#include <ns3/traced-callback.h>
+
+#include <cstdint>
+#include <deque>
+
+/*
+ * LrWpanMac 앞단의 크기 제한 송신 큐
+ *
+ * LrWpanMac::McpsDataRequest()는 CSMA-CA가 비우는 속도와 상관없이 요청을 MAC 내부 큐에 계속 쌓습니다.
+ * 이 큐는 MAC에 한 번에 한 요청만 넘기고(MCPS-DATA.confirm을 받으면 다음 요청), 나머지는 정해진 크기
+ * 안에서 정책에 따라 보관 / 폐기합니다.
+ *  - DropTail: 가득 차면 새 요청을 버림
+ *  - DropOldest: 가득 차면 가장 오래된 요청을 버리고 새 요청을 넣음
+ *  - Priority: 메시지 ID가 작은 요청부터 보냄, 가득 차면 ID가 가장 큰(가장 늦게 들어온) 요청을 버림
+ *  - MaxDelay: 0이 아니면 정책과 상관없이 큐에서 이 시간을 넘긴 요청을 MAC에 넘기기 전에 버림
+ *
+ * Install()이 MAC의 MCPS-DATA.confirm 콜백을 가져가므로, 시나리오의 confirm 콜백은
+ * SetMcpsDataConfirmCallback()으로 큐에 등록합니다.
+ */
+
+namespace ns3
+{
+
+/// @brief 크기 제한 / 폐기 정책 / 지연 텔레메트리를 가진 LR-WPAN 송신 큐
+class LrWpanTxQueue : public Object
+{
+  public:
+    /// @brief 가득 찼을 때의 정책
+    enum DropPolicy
+    {
+        DROP_TAIL,
+        DROP_OLDEST,
+        PRIORITY,
+    };
+
+    /// @brief 폐기 이유
+    enum DropReason
+    {
+        DROP_OVERFLOW,  ///< 큐가 가득 참
+        DROP_EXPIRED,   ///< MaxDelay 초과
+    };
+
+    /// @brief Drop 트레이스 시그니처
+    typedef void (*DropTracedCallback)(Ptr<const Packet> packet, DropReason reason);
+
+    /// @brief Dequeue 트레이스 시그니처, sojourn은 큐에 머문 시간
+    typedef void (*SojournTracedCallback)(Ptr<const Packet> packet, Time sojourn);
+
+    static TypeId GetTypeId();
+
+    LrWpanTxQueue();
+    ~LrWpanTxQueue() override;
+
+    /// @brief 디바이스의 MAC에 큐를 연결합니다. MAC의 MCPS-DATA.confirm 콜백을 덮어씁니다.
+    /// @param handles 송신 디바이스 핸들
+    void Install(const LrWpanHandles& handles);
+
+    /// @brief MAC에서 받은 MCPS-DATA.confirm을 넘겨받을 콜백
+    void SetMcpsDataConfirmCallback(McpsDataConfirmCallback callback);
+
+    /// @brief 요청을 큐에 넣고, MAC이 비어 있으면 바로 넘깁니다.
+    /// @param params MCPS-DATA.request params
+    /// @param packet 페이로드
+    /// @param messageId Priority 정책에서 쓰는 메시지 ID, 작을수록 먼저 보냄
+    /// @return 큐에 들어갔으면 true, 이 요청이 버려졌으면 false
+    bool Enqueue(const McpsDataRequestParams& params, Ptr<Packet> packet, uint32_t messageId = 0);
+
+    /// @brief 큐에 있는 요청 수(MAC에 넘긴 요청 제외)
+    uint32_t GetNPackets() const
+    {
+        return m_items.size();
+    }
+
+    uint64_t GetDropped() const
+    {
+        return m_dropped;
+    }
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    /// @brief 큐의 요청 하나
+    struct Item
+    {
+        McpsDataRequestParams params;
+        Ptr<Packet> packet;
+        uint32_t messageId;
+        Time enqueueTime;
+    };
+
+    /// @brief MaxDelay를 넘긴 요청을 모두 버립니다.
+    void DropExpired();
+
+    /// @brief 요청 하나를 큐에서 빼고 Drop 트레이스를 호출합니다.
+    void Drop(std::deque<Item>::iterator item, DropReason reason);
+
+    /// @brief 정책에 따라 다음에 보낼 요청을 고릅니다.
+    std::deque<Item>::iterator Next();
+
+    /// @brief MAC이 비어 있으면 다음 요청을 넘깁니다.
+    void Transmit();
+
+    void McpsDataConfirm(McpsDataConfirmParams params);
+
+    uint32_t m_maxSize;
+    DropPolicy m_policy;
+    Time m_maxDelay;
+
+    Ptr<LrWpanMac> m_mac;
+    McpsDataConfirmCallback m_confirmCallback;
+
+    std::deque<Item> m_items;
+    bool m_busy;                ///< MAC에 넘긴 요청의 confirm을 기다리는 중
+    uint64_t m_dropped;
+
+    TracedCallback<Ptr<const Packet>> m_enqueueTrace;
+    TracedCallback<Ptr<const Packet>, Time> m_dequeueTrace;
+    TracedCallback<Ptr<const Packet>, DropReason> m_dropTrace;
+};
+
+} // namespace ns3
+
+#endif /* LR_WPAN_TX_QUEUE_H */
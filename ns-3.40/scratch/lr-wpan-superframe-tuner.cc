@@ -0,0 +1,484 @@
+/*
+ * 슈퍼프레임 / CSMA-CA 설정 자동 탐색기
+ *
+ * macBeaconOrder(m_bcnOrd), macSuperframeOrder(m_sfrmOrd), macMinBE, macMaxCSMABackoffs
+ * 조합을 짧은 시뮬레이션으로 평가하고(successive halving), 성능이 나쁜 후보를
+ * 라운드마다 조기에 탈락시킵니다.
+ *
+ * 목적 함수: 듀티 사이클 예산(2^(SO-BO)) 안에서 p99 전송 지연(MCPS-DATA.request ->
+ * MCPS-DATA.confirm)을 최소화. 전송 성공률이 minPdr보다 낮은 후보는 탈락 처리합니다.
+ *
+ * 각 후보는 fork()한 자식 프로세스에서 독립적으로 시뮬레이션되며(Simulator는 프로세스당
+ * 하나), 결과는 pipe로 부모에게 전달됩니다.
+ *
+ * 사용 예:
+ *   ./ns3 run "lr-wpan-superframe-tuner --nodes=10 --interval=0.5 --dutyBudget=0.25 --jobs=8"
+ */
+#include <ns3/core-module.h>
+#include <ns3/lr-wpan-module.h>
+#include <ns3/mobility-module.h>
+#include <ns3/network-module.h>
+#include <ns3/simulator.h>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+using namespace ns3;
+
+const int COORDINATOR_PAN_ID = 5;
+const int COORDINATOR_CHANNEL = 12;
+
+/// 2.4 GHz O-QPSK 심볼 길이 (62.5 ksymbol/s)
+const double SYMBOL_SECONDS = 16e-6;
+
+
+/// @brief 탐색 대상이 되는 슈퍼프레임 / CSMA-CA 설정 하나
+struct SuperframeConfig
+{
+    uint8_t bcnOrd;         ///< macBeaconOrder, 15이면 비콘 미사용(non-beacon) PAN
+    uint8_t sfrmOrd;        ///< macSuperframeOrder
+    uint8_t minBE;          ///< macMinBE
+    uint8_t maxBackoffs;    ///< macMaxCSMABackoffs
+
+    /// @brief 코디네이터의 활성 구간 비율, 비콘 미사용 PAN은 항상 1
+    double DutyCycle() const
+    {
+        if(bcnOrd == 15)
+            return 1.0;
+        return std::pow(2.0, static_cast<int>(sfrmOrd) - static_cast<int>(bcnOrd));
+    }
+
+    /// @brief 비콘 간격(BI), 비콘 미사용 PAN은 0
+    Time BeaconInterval() const
+    {
+        if(bcnOrd == 15)
+            return Seconds(0);
+        return Seconds(aBaseSuperframeDuration * std::pow(2.0, bcnOrd) * SYMBOL_SECONDS);
+    }
+};
+
+
+/// @brief 짧은 시뮬레이션 한 번의 측정 결과, pipe로 그대로 전달되므로 POD로 유지
+struct TrialResult
+{
+    double p99LatencyMs;
+    double meanLatencyMs;
+    double deliveryRatio;
+    uint32_t sent;
+    uint32_t delivered;
+    bool valid;             ///< 자식 프로세스가 정상적으로 결과를 보냈는지 여부
+};
+
+
+/// @brief 명령행으로 설정하는 탐색 옵션
+struct TunerOptions
+{
+    uint32_t nodeCount = 10;        ///< 코디네이터를 제외한 디바이스 수
+    double spacing = 10.0;          ///< 디바이스 격자 간격 (m)
+    double interval = 1.0;          ///< 디바이스별 패킷 전송 간격 (s)
+    uint32_t payloadSize = 20;      ///< MSDU 크기 (byte)
+    double dutyBudget = 0.25;       ///< 허용되는 최대 듀티 사이클
+    double minPdr = 0.9;            ///< 허용되는 최소 전송 성공률
+    uint32_t minBcnOrd = 3;
+    uint32_t maxBcnOrd = 8;
+    uint32_t minBE = 0;             ///< macMinBE 탐색 하한
+    uint32_t maxBE = 5;             ///< macMaxBE (고정), macMinBE는 minBE..maxBE 범위에서 탐색
+    uint32_t maxBackoffsLimit = 5;  ///< macMaxCSMABackoffs 탐색 상한
+    double minBudget = 10.0;        ///< 첫 라운드의 측정 시간 (s)
+    uint32_t eta = 3;               ///< 라운드마다 남기는 비율의 역수
+    uint32_t jobs = 4;              ///< 동시에 실행하는 시뮬레이션 수
+    uint32_t seed = 1;
+};
+
+
+/////////////////////////// TRIAL ///////////////////////////
+
+/// @brief 자식 프로세스 하나에서 사용되는 측정 상태
+struct TrialStats
+{
+    std::vector<std::vector<Time>> requestTime;   ///< [디바이스][msduHandle] 요청 시각
+    std::vector<uint8_t> nextHandle;
+    std::vector<double> latencies;
+    Time measureEnd;
+    uint32_t sent = 0;
+};
+
+static TrialStats g_stats;
+
+
+/// @brief 디바이스의 MCPS-DATA.confirm 콜백, 측정 구간에서 보낸 패킷의 지연을 기록합니다.
+/// @param index 디바이스 인덱스
+/// @param params McpsDataConfirmParams
+static void
+McpsDataConfirm(uint32_t index, McpsDataConfirmParams params)
+{
+    Time requested = g_stats.requestTime[index][params.m_msduHandle];
+    if(params.m_status != IEEE_802_15_4_SUCCESS || requested.IsNegative())
+        return;
+
+    g_stats.latencies.push_back((Simulator::Now() - requested).GetSeconds() * 1e3);
+    g_stats.requestTime[index][params.m_msduHandle] = Seconds(-1);
+}
+
+
+/// @brief 측정 구간이 끝날 때까지 일정 간격으로 코디네이터에게 데이터를 보냅니다.
+/// @param index 디바이스 인덱스
+/// @param mac Ptr<LrWpanMac>
+/// @param payloadSize MSDU 크기
+/// @param interval 전송 간격
+static void
+SendData(uint32_t index, Ptr<LrWpanMac> mac, uint32_t payloadSize, Time interval)
+{
+    if(Simulator::Now() >= g_stats.measureEnd)
+        return;
+
+    McpsDataRequestParams params;
+    params.m_dstPanId = COORDINATOR_PAN_ID;
+    params.m_srcAddrMode = SHORT_ADDR;
+    params.m_dstAddrMode = SHORT_ADDR;
+    params.m_dstAddr = Mac16Address("00:01");
+    params.m_msduHandle = g_stats.nextHandle[index]++;
+    params.m_txOptions = TX_OPTION_ACK;
+
+    g_stats.requestTime[index][params.m_msduHandle] = Simulator::Now();
+    g_stats.sent++;
+
+    mac->McpsDataRequest(params, Create<Packet>(payloadSize));
+
+    Simulator::Schedule(interval, &SendData, index, mac, payloadSize, interval);
+}
+
+
+/// @brief 설정 하나를 주어진 측정 시간만큼 시뮬레이션합니다. 자식 프로세스에서만 호출됩니다.
+/// @param config 평가할 설정
+/// @param options 탐색 옵션
+/// @param measureSeconds 측정 구간 길이
+/// @return 측정 결과
+static TrialResult
+RunTrial(const SuperframeConfig& config, const TunerOptions& options, double measureSeconds)
+{
+    RngSeedManager::SetSeed(options.seed);
+    RngSeedManager::SetRun(1);
+
+    NodeContainer pan;
+    pan.Create(options.nodeCount + 1);      // 0번 노드가 코디네이터
+
+    MobilityHelper mobilityHelper;
+    mobilityHelper.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+    mobilityHelper.SetPositionAllocator("ns3::GridPositionAllocator",
+                                        "MinX", DoubleValue(0.0),
+                                        "MinY", DoubleValue(0.0),
+                                        "DeltaX", DoubleValue(options.spacing),
+                                        "DeltaY", DoubleValue(options.spacing),
+                                        "GridWidth", UintegerValue(5),
+                                        "LayoutType", StringValue("RowFirst"));
+    mobilityHelper.Install(pan);
+
+    LrWpanHelper lrWpanHelper;
+    NetDeviceContainer netDevices = lrWpanHelper.Install(pan);
+    lrWpanHelper.CreateAssociatedPan(netDevices, COORDINATOR_PAN_ID);
+
+    Ptr<LrWpanNetDevice> coordinatorNetDevice = DynamicCast<LrWpanNetDevice>(netDevices.Get(0));
+
+    // 코디네이터: 비콘 전송 시작 (bcnOrd가 15이면 비콘 미사용 PAN)
+    MlmeStartRequestParams startParams;
+    startParams.m_panCoor = true;
+    startParams.m_PanId = COORDINATOR_PAN_ID;
+    startParams.m_bcnOrd = config.bcnOrd;
+    startParams.m_sfrmOrd = config.sfrmOrd;
+    startParams.m_logCh = COORDINATOR_CHANNEL;
+    startParams.m_coorRealgn = false;
+    Simulator::ScheduleWithContext(pan.Get(0)->GetId(),
+                                   Seconds(1.0),
+                                   &LrWpanMac::MlmeStartRequest,
+                                   coordinatorNetDevice->GetMac(),
+                                   startParams);
+
+    // 비콘 동기화에 필요한 시간을 워밍업으로 두고 그 뒤부터 측정
+    Time warmup = Seconds(1.5) + config.BeaconInterval() * 2;
+    g_stats.measureEnd = warmup + Seconds(measureSeconds);
+    g_stats.requestTime.assign(options.nodeCount + 1, std::vector<Time>(256, Seconds(-1)));
+    g_stats.nextHandle.assign(options.nodeCount + 1, 0);
+
+    Ptr<UniformRandomVariable> jitter = CreateObject<UniformRandomVariable>();
+    for(uint32_t i = 1; i < netDevices.GetN(); i++)
+    {
+        Ptr<LrWpanNetDevice> netDevice = DynamicCast<LrWpanNetDevice>(netDevices.Get(i));
+        Ptr<LrWpanCsmaCa> csmaCa = netDevice->GetCsmaCa();
+        csmaCa->SetMacMaxBE(options.maxBE);
+        csmaCa->SetMacMinBE(config.minBE);
+        csmaCa->SetMacMaxCSMABackoffs(config.maxBackoffs);
+
+        netDevice->GetMac()->SetMcpsDataConfirmCallback(MakeBoundCallback(&McpsDataConfirm, i));
+
+        if(config.bcnOrd < 15)
+        {
+            // 비콘을 추적하며 슬롯 CSMA-CA로 동작
+            MlmeSyncRequestParams syncParams;
+            syncParams.m_logCh = COORDINATOR_CHANNEL;
+            syncParams.m_trackBcn = true;
+            Simulator::ScheduleWithContext(pan.Get(i)->GetId(),
+                                           Seconds(1.0),
+                                           &LrWpanMac::MlmeSyncRequest,
+                                           netDevice->GetMac(),
+                                           syncParams);
+        }
+
+        Simulator::ScheduleWithContext(pan.Get(i)->GetId(),
+                                       warmup + Seconds(jitter->GetValue(0, options.interval)),
+                                       &SendData,
+                                       i,
+                                       netDevice->GetMac(),
+                                       options.payloadSize,
+                                       Seconds(options.interval));
+    }
+
+    // 측정 종료 후 큐에 남은 패킷이 비울 수 있도록 비콘 간격 두 번만큼 더 진행
+    Simulator::Stop(g_stats.measureEnd + config.BeaconInterval() * 2 + Seconds(1));
+    Simulator::Run();
+    Simulator::Destroy();
+
+    TrialResult result;
+    std::memset(&result, 0, sizeof(result));
+    result.valid = true;
+    result.sent = g_stats.sent;
+    result.delivered = g_stats.latencies.size();
+    result.deliveryRatio = result.sent ? static_cast<double>(result.delivered) / result.sent : 0.0;
+
+    if(!g_stats.latencies.empty())
+    {
+        std::sort(g_stats.latencies.begin(), g_stats.latencies.end());
+        size_t p99Idx = static_cast<size_t>(std::ceil(0.99 * g_stats.latencies.size())) - 1;
+        result.p99LatencyMs = g_stats.latencies[p99Idx];
+        double sum = 0;
+        for(double latency : g_stats.latencies)
+            sum += latency;
+        result.meanLatencyMs = sum / g_stats.latencies.size();
+    }
+    else
+    {
+        result.p99LatencyMs = std::numeric_limits<double>::infinity();
+    }
+
+    return result;
+}
+
+
+/////////////////////////// SEARCH ///////////////////////////
+
+/// @brief 탐색 후보와 가장 최근 라운드의 결과
+struct Candidate
+{
+    SuperframeConfig config;
+    TrialResult result;
+};
+
+
+/// @brief 목적 함수 값, 작을수록 좋음. 성공률 제약을 만족하지 못하면 무한대
+/// @param result 측정 결과
+/// @param options 탐색 옵션
+static double
+Score(const TrialResult& result, const TunerOptions& options)
+{
+    if(!result.valid || result.deliveryRatio < options.minPdr)
+        return std::numeric_limits<double>::infinity();
+    return result.p99LatencyMs;
+}
+
+
+/// @brief 듀티 사이클 예산을 만족하는 설정만 후보로 생성합니다. 예산을 넘는 설정은 시뮬레이션하지 않습니다.
+/// @param options 탐색 옵션
+/// @return 후보 목록
+static std::vector<Candidate>
+EnumerateCandidates(const TunerOptions& options)
+{
+    std::vector<uint8_t> beaconOrders;
+    for(uint32_t bo = options.minBcnOrd; bo <= options.maxBcnOrd && bo < 15; bo++)
+        beaconOrders.push_back(bo);
+    if(options.dutyBudget >= 1.0)
+        beaconOrders.push_back(15);
+
+    std::vector<Candidate> candidates;
+    for(uint8_t bo : beaconOrders)
+    {
+        for(uint8_t so = 0; so <= bo; so++)
+        {
+            SuperframeConfig config {bo, bo == 15 ? uint8_t(15) : so, 0, 0};
+            if(config.DutyCycle() > options.dutyBudget)
+                continue;
+
+            for(uint8_t minBE = options.minBE; minBE <= options.maxBE; minBE++)
+            {
+                for(uint8_t backoffs = 0; backoffs <= options.maxBackoffsLimit; backoffs++)
+                {
+                    config.minBE = minBE;
+                    config.maxBackoffs = backoffs;
+                    candidates.push_back(Candidate {config, TrialResult()});
+                }
+            }
+
+            if(bo == 15)
+                break;
+        }
+    }
+    return candidates;
+}
+
+
+/// @brief 후보들을 fork()한 자식 프로세스에서 최대 jobs개씩 병렬로 시뮬레이션합니다.
+/// @param candidates 평가할 후보, 결과가 채워짐
+/// @param options 탐색 옵션
+/// @param measureSeconds 이번 라운드의 측정 시간
+static void
+EvaluateParallel(std::vector<Candidate>& candidates, const TunerOptions& options, double measureSeconds)
+{
+    struct Running
+    {
+        pid_t pid;
+        int fd;
+        size_t index;
+    };
+
+    std::vector<Running> running;
+    size_t next = 0;
+
+    while(next < candidates.size() || !running.empty())
+    {
+        // 빈 슬롯만큼 자식 프로세스 생성
+        while(next < candidates.size() && running.size() < options.jobs)
+        {
+            int fds[2];
+            NS_ABORT_MSG_IF(pipe(fds) != 0, "pipe() failed: " << std::strerror(errno));
+
+            pid_t pid = fork();
+            NS_ABORT_MSG_IF(pid < 0, "fork() failed: " << std::strerror(errno));
+
+            if(pid == 0)
+            {
+                close(fds[0]);
+                TrialResult result = RunTrial(candidates[next].config, options, measureSeconds);
+                ssize_t written = write(fds[1], &result, sizeof(result));
+                close(fds[1]);
+                _exit(written == sizeof(result) ? 0 : 1);
+            }
+
+            close(fds[1]);
+            running.push_back(Running {pid, fds[0], next});
+            next++;
+        }
+
+        // 가장 먼저 생성된 자식의 결과를 수거
+        Running done = running.front();
+        running.erase(running.begin());
+
+        TrialResult result;
+        std::memset(&result, 0, sizeof(result));
+        if(read(done.fd, &result, sizeof(result)) != sizeof(result))
+            result.valid = false;
+        close(done.fd);
+        waitpid(done.pid, nullptr, 0);
+
+        candidates[done.index].result = result;
+    }
+}
+
+
+/// @brief 설정 하나를 출력합니다.
+static std::ostream&
+operator<<(std::ostream& os, const SuperframeConfig& config)
+{
+    os << "BO=" << +config.bcnOrd
+       << " SO=" << +config.sfrmOrd
+       << " minBE=" << +config.minBE
+       << " maxBackoffs=" << +config.maxBackoffs;
+    return os;
+}
+
+
+int main(int argc, char* argv[])
+{
+    TunerOptions options;
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("nodes", "코디네이터를 제외한 디바이스 수", options.nodeCount);
+    cmd.AddValue("spacing", "디바이스 격자 간격 (m)", options.spacing);
+    cmd.AddValue("interval", "디바이스별 패킷 전송 간격 (s)", options.interval);
+    cmd.AddValue("payload", "MSDU 크기 (byte)", options.payloadSize);
+    cmd.AddValue("dutyBudget", "허용되는 최대 듀티 사이클 2^(SO-BO)", options.dutyBudget);
+    cmd.AddValue("minPdr", "허용되는 최소 전송 성공률", options.minPdr);
+    cmd.AddValue("minBcnOrd", "탐색할 최소 macBeaconOrder", options.minBcnOrd);
+    cmd.AddValue("maxBcnOrd", "탐색할 최대 macBeaconOrder", options.maxBcnOrd);
+    cmd.AddValue("minBE", "탐색할 최소 macMinBE", options.minBE);
+    cmd.AddValue("maxBE", "macMaxBE", options.maxBE);
+    cmd.AddValue("maxBackoffs", "탐색할 최대 macMaxCSMABackoffs", options.maxBackoffsLimit);
+    cmd.AddValue("minBudget", "첫 라운드의 측정 시간 (s)", options.minBudget);
+    cmd.AddValue("eta", "라운드마다 1/eta만 남김", options.eta);
+    cmd.AddValue("jobs", "동시에 실행할 시뮬레이션 수", options.jobs);
+    cmd.AddValue("seed", "난수 시드", options.seed);
+    cmd.Parse(argc, argv);
+
+    NS_ABORT_MSG_IF(options.eta < 2, "eta must be at least 2");
+    // 범위를 벗어난 값은 fork된 자식의 SetMacMaxBE() / SetMacMinBE()에서야 실패하므로 여기서 거름
+    NS_ABORT_MSG_IF(options.maxBE < 3 || options.maxBE > 8, "macMaxBE must be in 3..8");
+    NS_ABORT_MSG_IF(options.minBE > options.maxBE, "macMinBE must not exceed macMaxBE");
+    NS_ABORT_MSG_IF(options.maxBackoffsLimit > 5, "macMaxCSMABackoffs must be in 0..5");
+    options.jobs = std::max<uint32_t>(options.jobs, 1);
+
+    std::vector<Candidate> candidates = EnumerateCandidates(options);
+    NS_ABORT_MSG_IF(candidates.empty(), "no configuration satisfies the duty-cycle budget");
+
+    std::cout << candidates.size() << " candidates within duty-cycle budget " << options.dutyBudget << std::endl;
+
+    // successive halving: 라운드마다 측정 시간을 eta배로 늘리고 상위 1/eta만 남김
+    double measureSeconds = options.minBudget;
+    for(uint32_t round = 0; ; round++)
+    {
+        std::cout << "round " << round << ": " << candidates.size()
+                  << " candidates, " << measureSeconds << " s each" << std::endl;
+
+        EvaluateParallel(candidates, options, measureSeconds);
+
+        std::stable_sort(candidates.begin(), candidates.end(),
+                         [&options](const Candidate& a, const Candidate& b) {
+                             return Score(a.result, options) < Score(b.result, options);
+                         });
+
+        // 제약을 만족하지 못하는 후보는 라운드와 관계없이 탈락
+        while(candidates.size() > 1 && std::isinf(Score(candidates.back().result, options)))
+            candidates.pop_back();
+
+        if(candidates.size() == 1)
+            break;
+
+        size_t keep = std::max<size_t>(1, (candidates.size() + options.eta - 1) / options.eta);
+        candidates.resize(keep);
+        measureSeconds *= options.eta;
+    }
+
+    const Candidate& best = candidates.front();
+    if(std::isinf(Score(best.result, options)))
+    {
+        std::cout << "no configuration reached delivery ratio " << options.minPdr << std::endl;
+        return 1;
+    }
+
+    std::cout << std::fixed << std::setprecision(3)
+              << "best: " << best.config
+              << ", duty cycle " << best.config.DutyCycle()
+              << ", p99 latency " << best.result.p99LatencyMs << " ms"
+              << ", mean latency " << best.result.meanLatencyMs << " ms"
+              << ", delivery ratio " << best.result.deliveryRatio
+              << " (" << best.result.delivered << "/" << best.result.sent << ")"
+              << std::endl;
+
+    return 0;
+}
@@ -1,3 +1,5 @@
+#include "lr-wpan-scenario/lr-wpan-scenario.h"
+
 #include <ns3/core-module.h>
 #include <ns3/lr-wpan-module.h>
 #include <ns3/simulator.h>
@@ -361,19 +363,24 @@ int main(int argc, char *argv[]) {
                                    coordinatorNetDevice->GetMac(),
                                    params);
 
+    // 디바이스 핸들 캐시
+    LrWpanDeviceTable table;
+    for(NodeContainer::Iterator i = devices.Begin(); i != devices.End(); i++)
+        table.Add((*i)->GetDevice(0));
+
     // 디바이스 설정
-    for(NodeContainer::Iterator i = devices.Begin(); i != devices.End(); i++) {
-        Ptr<Node> node = *i;
-        Ptr<LrWpanNetDevice> netDevice = DynamicCast<LrWpanNetDevice>(node->GetDevice(0));
+    for(uint32_t i = 0; i < table.GetN(); i++) {
+        const LrWpanHandles& handles = table[i];
+        Ptr<LrWpanNetDevice> netDevice = handles.device;
 
         // MLME-SCAN.confirm | MLME-ASSOCIATE.confirm | MCPS-DATA.indication | MCPS-DATA.confirm
-        netDevice->GetMac()->SetMlmeScanConfirmCallback(
+        handles.mac->SetMlmeScanConfirmCallback(
             MakeBoundCallback(&MlmeScanConfirm, netDevice));
-        netDevice->GetMac()->SetMlmeAssociateConfirmCallback(
+        handles.mac->SetMlmeAssociateConfirmCallback(
             MakeBoundCallback(&MlmeAssociateConfirm, netDevice));
-        netDevice->GetMac()->SetMcpsDataIndicationCallback(
+        handles.mac->SetMcpsDataIndicationCallback(
         MakeBoundCallback(&McpsDataIndication, netDevice));
-        netDevice->GetMac()->SetMcpsDataConfirmCallback(
+        handles.mac->SetMcpsDataConfirmCallback(
             MakeBoundCallback(&McpsDataConfirm, netDevice));
 
         // Devices initiate channels scan on channels 11, 12, 13, and 14 looking for beacons
@@ -392,37 +399,22 @@ int main(int argc, char *argv[]) {
         // We start the scanning process 100 milliseconds apart for each device
         // to avoid a storm of association requests with the coordinators
         // 디바이스별 비콘 신호 스캔 시작: MLME-SCAN.request
-        Time jitter = Seconds(2) + MilliSeconds(std::distance(devices.Begin(), i) * 100);
-        Simulator::ScheduleWithContext(node->GetId(),
+        Time jitter = Seconds(2) + MilliSeconds(i * 100);
+        Simulator::ScheduleWithContext(handles.nodeId,
                                        jitter,
                                        &LrWpanMac::MlmeScanRequest,
-                                       netDevice->GetMac(),
+                                       handles.mac,
                                        scanParams);
     }
 
     // 여기부터는 PAN이 잘 구성되었다고 가정하고 진행
 
-    // 한 디바이스에서 코디네이터로 데이터 전송
-    // 패킷 만들기
-    std::string string = "Hi there!";
-    Ptr<Packet> packet = Create<Packet>((uint8_t*) string.c_str(), string.length());
-
-    // 임의 디바이스에서 코디네이터로 데이터 전송
-    Ptr<LrWpanNetDevice> someNetDevice = DynamicCast<LrWpanNetDevice>(devices.Get(0)->GetDevice(0));
-    McpsDataRequestParams params2;
-    params2.m_dstPanId = COORDINATOR_PAN_ID;
-    params2.m_srcAddrMode = SHORT_ADDR;
-    params2.m_dstAddrMode = SHORT_ADDR;
-    params2.m_dstAddr = Mac16Address(COORDINATOR_MAC_ADDR);
-    params2.m_msduHandle = 1;
-    params2.m_txOptions = TX_OPTION_ACK;  // Enable direct transmission with Ack
-    Simulator::Schedule(
-        Seconds(1500),
-        &LrWpanMac::McpsDataRequest,
-        someNetDevice->GetMac(),
-        params2,
-        packet
-    );
+    // 임의 디바이스에서 코디네이터로 데이터 전송, ACK 사용
+    std::vector<McpsDataSubmission> batch = {
+        {0, CreateMcpsDataRequestParams(Mac16Address(COORDINATOR_MAC_ADDR), COORDINATOR_PAN_ID, SHORT_ADDR, TX_OPTION_ACK),
+         CreateMessagePacket("Hi there!"), Seconds(1500)},
+    };
+    SubmitMcpsDataRequests(table, batch);
 
     Simulator::Stop(Seconds(2000));
     Simulator::Run();
@@ -1,3 +1,5 @@
+#include "lr-wpan-scenario/lr-wpan-scenario.h"
+
 #include <ns3/core-module.h>
 #include <ns3/simulator.h>
 #include <ns3/lr-wpan-module.h>
@@ -24,56 +26,6 @@
 
 using namespace ns3;
 
-// Simulator::ScheduleWithContext ID
-static int eventId = 0;
-
-/// @brief Node로부터 LrWpanNetDevice를 형변환하여 반환하는 함수
-/// @param lrWpanNode 대상 노드
-/// @param deviceIndex NetDevice의 인덱스
-/// @return LrWpanNetDevice로 형변환된 대상 노드의 NetDevice Ptr
-static Ptr<LrWpanNetDevice> getLrWpanDevice(Ptr<Node> lrWpanNode, int deviceIndex)
-{
-    return DynamicCast<LrWpanNetDevice>(lrWpanNode->GetDevice(deviceIndex));
-}
-
-
-/// @brief MCPS-DATA.request 이벤트를 등록합니다.
-/// @param params McpsDataRequestParams
-/// @param lrWpanMac Ptr<LrWpanMac>
-/// @param packet Ptr<Packet>
-/// @param delay Time
-static void SetMcpsDataRequest(McpsDataRequestParams params, Ptr<LrWpanMac> lrWpanMac, std::string message, Time delay)
-{
-    Simulator::ScheduleWithContext(
-        eventId++,
-        delay,
-        &LrWpanMac::McpsDataRequest,
-        lrWpanMac,
-        params,
-        Create<Packet>((uint8_t*) message.c_str(), message.length())
-    );
-}
-
-/// @brief MCPS-DATA.request params 구조체를 만듭니다.
-/// @param dstAddr 목적지 MAC 주소
-/// @param dstPanId 목적지 PAN ID
-/// @param addrMode LrWpanAddressMode
-/// @param txOption TX_OPTION_ACK, TX_OPTION_NONE: TX_OPTION_GTS, TX_OPTION_INDIRECT는 현재 미지원
-/// @return McpsDatRequestParams
-static McpsDataRequestParams createMcpsDataRequestParams(Mac16Address dstAddr, int dstPanId, LrWpanAddressMode addrMode, int txOption)
-{
-    static int msduHandle = 0;
-
-    McpsDataRequestParams params;
-    params.m_dstAddrMode = params.m_srcAddrMode = addrMode;
-    params.m_dstAddr = dstAddr;
-    params.m_dstPanId = dstPanId;
-    params.m_txOptions = txOption;
-    params.m_msduHandle = msduHandle++;
-
-    return params;
-}
-
 //////////////////// CALLBACKS ////////////////////
 
 static void McpsDataConfirm(McpsDataConfirmParams params)
@@ -107,29 +59,23 @@ int main(int argc, char* argv[])
     NetDeviceContainer netDevices = lrWpanHelper.Install(pan);
     lrWpanHelper.CreateAssociatedPan(netDevices, COORDINATOR_PAN_ID);   // 첫 번째 노드가 코디네이터, PAN ID는 5
 
-    // 코디네이터
-    Ptr<Node> coordinator = pan.Get(0);
-    Ptr<LrWpanNetDevice> coordinatorNetDevice = getLrWpanDevice(coordinator, 0);
+    LrWpanDeviceTable table(netDevices);
 
-    // 임의 노드
-    Ptr<Node> someNode = pan.Get(5);
-    Ptr<LrWpanNetDevice> someNodeNetDevice = getLrWpanDevice(someNode, 0);
+    // 코디네이터
+    const LrWpanHandles& coordinator = table[0];
 
     // 모든 노드에 callback 설정
-    for(NodeContainer::Iterator nodePtr = pan.Begin(); nodePtr != pan.End(); nodePtr++)
+    for(const LrWpanHandles& handles : table)
     {
-        Ptr<Node> node = *nodePtr;
-        someNodeNetDevice = DynamicCast<LrWpanNetDevice>(node->GetDevice(0));
-
-        someNodeNetDevice->GetMac()->SetMcpsDataConfirmCallback(
+        handles.mac->SetMcpsDataConfirmCallback(
             MakeBoundCallback(&McpsDataConfirm)
         );
 
-        someNodeNetDevice->GetMac()->SetMcpsDataIndicationCallback(
+        handles.mac->SetMcpsDataIndicationCallback(
             MakeBoundCallback(&McpsDataIndication)
         );
 
-        Ptr<LrWpanCsmaCa> csmaCa = someNodeNetDevice->GetCsmaCa();
+        Ptr<LrWpanCsmaCa> csmaCa = handles.csmaCa;
 
         csmaCa->SetSlottedCsmaCa();
         csmaCa->SetMacMinBE(0);
@@ -137,37 +83,26 @@ int main(int argc, char* argv[])
         csmaCa->SetMacMaxCSMABackoffs(0);
     }
 
-    SetMcpsDataRequest(
-        createMcpsDataRequestParams(Mac16Address("00:01"), COORDINATOR_PAN_ID, SHORT_ADDR, TX_OPTION_NONE),
-        DynamicCast<LrWpanNetDevice>(pan.Get(4)->GetDevice(0))->GetMac(),
-        "message from node 5",
-        Seconds(0.1)
-    );
-
-    SetMcpsDataRequest(
-        createMcpsDataRequestParams(Mac16Address("00:01"), COORDINATOR_PAN_ID, SHORT_ADDR, TX_OPTION_NONE),
-        DynamicCast<LrWpanNetDevice>(pan.Get(7)->GetDevice(0))->GetMac(),
-        "message from node 8",
-        Seconds(0)
-    );
-
-    SetMcpsDataRequest(
-        createMcpsDataRequestParams(Mac16Address("00:01"), COORDINATOR_PAN_ID, SHORT_ADDR, TX_OPTION_NONE),
-        DynamicCast<LrWpanNetDevice>(pan.Get(1)->GetDevice(0))->GetMac(),
-        "message from node 2",
-        Seconds(0)
-    );
-
-    coordinatorNetDevice->GetMac()->SetMcpsDataConfirmCallback(
+    std::vector<McpsDataSubmission> batch = {
+        {4, CreateMcpsDataRequestParams(Mac16Address("00:01"), COORDINATOR_PAN_ID, SHORT_ADDR, TX_OPTION_NONE),
+         CreateMessagePacket("message from node 5"), Seconds(0.1)},
+        {7, CreateMcpsDataRequestParams(Mac16Address("00:01"), COORDINATOR_PAN_ID, SHORT_ADDR, TX_OPTION_NONE),
+         CreateMessagePacket("message from node 8"), Seconds(0)},
+        {1, CreateMcpsDataRequestParams(Mac16Address("00:01"), COORDINATOR_PAN_ID, SHORT_ADDR, TX_OPTION_NONE),
+         CreateMessagePacket("message from node 2"), Seconds(0)},
+    };
+    SubmitMcpsDataRequests(table, batch);
+
+    coordinator.mac->SetMcpsDataConfirmCallback(
         MakeCallback(&McpsDataConfirm)
     );
 
-    coordinatorNetDevice->GetMac()->SetMcpsDataIndicationCallback(
+    coordinator.mac->SetMcpsDataIndicationCallback(
         MakeCallback(&McpsDataIndication)
     );
 
 
-    Ptr<LrWpanCsmaCa> csmaCa = coordinatorNetDevice->GetCsmaCa();
+    Ptr<LrWpanCsmaCa> csmaCa = coordinator.csmaCa;
     csmaCa->SetSlottedCsmaCa();
     csmaCa->SetMacMinBE(0);
     csmaCa->SetMacMinBE(0);
@@ -0,0 +1,271 @@
+/*
+ * 송신 fast path(패킷 풀 + params 템플릿) 할당 / CPU 측정
+ *
+ * 시나리오들은 보낼 때마다 Create<Packet>()으로 패킷을 새로 만들고 McpsDataRequestParams를 처음부터
+ * 채웠습니다. lr-wpan-scenario의 McpsDataFlow는 디바이스별 LrWpanPacketPool에서 전송이 끝난 패킷을
+ * 다시 쓰고, 흐름마다 고정된 params에서 msduHandle만 바꿉니다.
+ *
+ * 디바이스 n개가 코디네이터(00:01)에게 주기적으로 보내는 PAN을 두 방식으로 같은 조건에서 실행하고,
+ * 전역 operator new를 가로채 다음을 출력합니다.
+ *  - send allocs/frame: 송신 함수(패킷 / params 준비 + McpsDataRequest 호출) 안에서 일어난 할당 수
+ *  - total allocs/frame: Simulator::Run() 전체(MAC / PHY / 채널 포함)의 할당 수
+ *  - ns/frame: Simulator::Run()의 wall-clock 시간
+ *
+ * MAC 헤더 / 트레일러 직렬화는 src/lr-wpan의 LrWpanMac::McpsDataRequest() 안에서 일어나므로
+ * 이 측정에는 두 방식 모두 같은 비용으로 포함됩니다.
+ *
+ * 사용 예:
+ *   ./ns3 run "lr-wpan-tx-fastpath-bench --devices=8 --frames=5000"
+ */
+#include "lr-wpan-scenario/lr-wpan-scenario.h"
+
+#include <ns3/core-module.h>
+#include <ns3/lr-wpan-module.h>
+#include <ns3/mobility-module.h>
+#include <ns3/network-module.h>
+#include <ns3/simulator.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <vector>
+
+using namespace ns3;
+
+const int COORDINATOR_PAN_ID = 5;
+const uint32_t PAYLOAD_SIZE = 20;
+
+
+//////////////////// 할당 카운터 ////////////////////
+
+static uint64_t g_allocations = 0;
+static uint64_t g_allocatedBytes = 0;
+
+
+void*
+operator new(std::size_t size)
+{
+    g_allocations++;
+    g_allocatedBytes += size;
+    if(void* p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+
+void
+operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+
+void
+operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+
+//////////////////// 측정 ////////////////////
+
+/// @brief 실행 한 번의 측정 결과
+struct FastPathResult
+{
+    uint64_t sent = 0;              ///< McpsDataRequest 호출 수
+    uint64_t confirmed = 0;         ///< SUCCESS confirm 수
+    uint64_t delivered = 0;         ///< 코디네이터가 받은 프레임 수
+    uint64_t sendAllocations = 0;   ///< 송신 함수 안의 할당 수
+    uint64_t runAllocations = 0;    ///< Simulator::Run() 전체의 할당 수
+    uint64_t runBytes = 0;
+    uint64_t poolReused = 0;
+    uint64_t poolCreated = 0;
+    double wallSeconds = 0;
+};
+
+static FastPathResult g_result;
+
+
+static void
+McpsDataConfirm(McpsDataConfirmParams params)
+{
+    if(params.m_status == IEEE_802_15_4_SUCCESS)
+        g_result.confirmed++;
+}
+
+
+static void
+McpsDataIndication(McpsDataIndicationParams params, Ptr<Packet> p)
+{
+    g_result.delivered++;
+}
+
+
+/// @brief 디바이스 하나의 송신 상태
+struct Sender
+{
+    LrWpanHandles handles;
+    McpsDataFlow flow;
+    uint8_t payload[PAYLOAD_SIZE] = {};
+    uint32_t framesLeft = 0;
+};
+
+
+/// @brief 기존 시나리오 방식: 매번 패킷과 params를 새로 만듭니다.
+static void
+SendBaseline(Sender* sender, Time period)
+{
+    uint64_t allocations = g_allocations;
+
+    sender->payload[0]++;
+    sender->handles.mac->McpsDataRequest(
+        CreateMcpsDataRequestParams(Mac16Address("00:01"), COORDINATOR_PAN_ID, SHORT_ADDR, TX_OPTION_NONE),
+        Create<Packet>(sender->payload, PAYLOAD_SIZE)
+    );
+
+    g_result.sendAllocations += g_allocations - allocations;
+    g_result.sent++;
+
+    if(--sender->framesLeft > 0)
+        Simulator::Schedule(period, &SendBaseline, sender, period);
+}
+
+
+/// @brief fast path: 풀 패킷과 params 템플릿으로 보냅니다.
+static void
+SendFastPath(Sender* sender, Time period)
+{
+    uint64_t allocations = g_allocations;
+
+    sender->payload[0]++;
+    sender->flow.Send(sender->payload, PAYLOAD_SIZE);
+
+    g_result.sendAllocations += g_allocations - allocations;
+    g_result.sent++;
+
+    if(--sender->framesLeft > 0)
+        Simulator::Schedule(period, &SendFastPath, sender, period);
+}
+
+
+/// @brief 디바이스 n개가 period마다 한 프레임씩 보내는 PAN을 실행합니다.
+/// @param fastPath McpsDataFlow 사용 여부
+/// @param devices 송신 디바이스 수
+/// @param frames 디바이스당 프레임 수
+/// @param period 디바이스별 송신 간격
+/// @return 측정 결과
+static FastPathResult
+RunFastPath(bool fastPath, uint32_t devices, uint32_t frames, Time period)
+{
+    g_result = FastPathResult();
+
+    NodeContainer pan;
+    pan.Create(devices + 1);
+
+    MobilityHelper mobilityHelper;
+    mobilityHelper.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+    mobilityHelper.SetPositionAllocator("ns3::UniformDiscPositionAllocator",
+                                        "rho", DoubleValue(10.0));
+    mobilityHelper.Install(pan);
+
+    LrWpanHelper lrWpanHelper;
+    NetDeviceContainer netDevices = lrWpanHelper.Install(pan);
+    lrWpanHelper.CreateAssociatedPan(netDevices, COORDINATOR_PAN_ID);
+
+    LrWpanDeviceTable table(netDevices);
+    table[0].mac->SetMcpsDataIndicationCallback(MakeCallback(&McpsDataIndication));
+
+    McpsDataRequestParams params =
+        CreateMcpsDataRequestParams(Mac16Address("00:01"), COORDINATOR_PAN_ID, SHORT_ADDR, TX_OPTION_NONE);
+
+    std::vector<Sender> senders;
+    senders.reserve(devices);
+    for(uint32_t i = 1; i < table.GetN(); i++)
+    {
+        table[i].mac->SetMcpsDataConfirmCallback(MakeCallback(&McpsDataConfirm));
+        senders.push_back({table[i], McpsDataFlow(table[i], params)});
+        senders.back().framesLeft = frames;
+    }
+
+    // 디바이스마다 period / n씩 어긋나게 시작해 충돌 없이 CSMA-CA가 비워지도록 함
+    for(uint32_t i = 0; i < senders.size(); i++)
+    {
+        Time start = Seconds(0.1) + period * i / senders.size();
+        Simulator::ScheduleWithContext(senders[i].handles.nodeId, start,
+                                       fastPath ? &SendFastPath : &SendBaseline, &senders[i], period);
+    }
+    Simulator::Stop(Seconds(0.2) + period * frames);
+
+    uint64_t allocations = g_allocations;
+    uint64_t bytes = g_allocatedBytes;
+    auto wallStart = std::chrono::steady_clock::now();
+    Simulator::Run();
+    g_result.wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+    g_result.runAllocations = g_allocations - allocations;
+    g_result.runBytes = g_allocatedBytes - bytes;
+
+    for(const Sender& sender : senders)
+    {
+        g_result.poolReused += sender.handles.packetPool->GetReused();
+        g_result.poolCreated += sender.handles.packetPool->GetCreated();
+    }
+
+    Simulator::Destroy();
+    return g_result;
+}
+
+
+static void
+PrintResult(const std::string& mode, const FastPathResult& result)
+{
+    double frames = result.sent ? result.sent : 1;
+
+    std::cout
+        << std::left
+        << std::setw(10) << mode
+        << std::setw(10) << result.sent
+        << std::setw(11) << result.confirmed
+        << std::setw(11) << result.delivered
+        << std::setw(18) << std::fixed << std::setprecision(2) << result.sendAllocations / frames
+        << std::setw(19) << result.runAllocations / frames
+        << std::setw(16) << std::setprecision(1) << result.runBytes / frames
+        << std::setw(12) << result.wallSeconds * 1e9 / frames
+        << result.poolReused << "/" << result.poolCreated
+        << std::endl
+    ;
+}
+
+
+int main(int argc, char* argv[])
+{
+    uint32_t devices = 8;
+    uint32_t frames = 2000;
+    uint32_t periodMs = 50;
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("devices", "송신 디바이스 수", devices);
+    cmd.AddValue("frames", "디바이스당 프레임 수", frames);
+    cmd.AddValue("period", "디바이스별 송신 간격(ms)", periodMs);
+    cmd.Parse(argc, argv);
+
+    std::cout
+        << std::left
+        << std::setw(10) << "mode"
+        << std::setw(10) << "sent"
+        << std::setw(11) << "confirmed"
+        << std::setw(11) << "delivered"
+        << std::setw(18) << "send allocs/frame"
+        << std::setw(19) << "total allocs/frame"
+        << std::setw(16) << "bytes/frame"
+        << std::setw(12) << "ns/frame"
+        << "pool reused/created"
+        << std::endl
+    ;
+
+    PrintResult("baseline", RunFastPath(false, devices, frames, MilliSeconds(periodMs)));
+    PrintResult("fastpath", RunFastPath(true, devices, frames, MilliSeconds(periodMs)));
+
+    return 0;
+}
@@ -0,0 +1,244 @@
+/*
+ * 과부하에서 송신 큐 정책별 지연 / 손실 비교
+ *
+ * 디바이스 하나가 CSMA-CA + ACK로 비울 수 있는 속도보다 빠르게 코디네이터(00:01)에게 보냅니다.
+ * 메시지의 일부는 높은 우선순위 ID(CAN처럼 작을수록 우선), 나머지는 낮은 우선순위 ID를 가집니다.
+ *  - unbounded: 기존처럼 LrWpanMac::McpsDataRequest()를 바로 호출(MAC 내부 큐에 계속 쌓임)
+ *  - droptail / dropoldest / priority: LrWpanTxQueue의 각 정책
+ *  - deadline: DropTail + MaxDelay
+ *
+ * 코디네이터가 받은 프레임의 생성 시각으로 종단 지연을 재고, 큐의 Dequeue 트레이스로 큐 대기 시간을 잽니다.
+ * unbounded는 시간이 지날수록 지연이 커지고, 큐를 쓰면 새 데이터의 지연이 큐 크기 / MaxDelay로 제한됩니다.
+ *
+ * 사용 예:
+ *   ./ns3 run "lr-wpan-tx-queue-overload --period=1 --duration=5 --queueSize=8 --maxDelay=50"
+ */
+#include "lr-wpan-scenario/lr-wpan-scenario.h"
+#include "lr-wpan-scenario/lr-wpan-tx-queue.h"
+
+#include <ns3/core-module.h>
+#include <ns3/lr-wpan-module.h>
+#include <ns3/mobility-module.h>
+#include <ns3/network-module.h>
+#include <ns3/simulator.h>
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+using namespace ns3;
+
+const int COORDINATOR_PAN_ID = 5;
+const uint32_t HIGH_PRIORITY_ID = 0x010;
+const uint32_t LOW_PRIORITY_ID = 0x300;
+
+
+/// @brief 페이로드: 생성 시각과 메시지 ID
+struct QueuePayload
+{
+    int64_t createdNs;
+    uint32_t messageId;
+};
+
+
+/// @brief 실행 한 번의 측정 결과
+struct QueueResult
+{
+    uint64_t generated = 0;
+    uint64_t dropped = 0;                   ///< 큐가 버린 요청 수
+    std::vector<double> latencyMs;          ///< 받은 프레임의 종단 지연
+    std::vector<double> highLatencyMs;      ///< 높은 우선순위 프레임의 종단 지연
+    double sojournSumMs = 0;
+    double sojournMaxMs = 0;
+    uint64_t dequeued = 0;
+};
+
+static QueueResult g_result;
+
+
+static void
+McpsDataIndication(McpsDataIndicationParams params, Ptr<Packet> p)
+{
+    QueuePayload payload;
+    if(p->GetSize() < sizeof(payload))
+        return;
+    p->CopyData(reinterpret_cast<uint8_t*>(&payload), sizeof(payload));
+
+    double latencyMs = (Simulator::Now().GetNanoSeconds() - payload.createdNs) / 1e6;
+    g_result.latencyMs.push_back(latencyMs);
+    if(payload.messageId == HIGH_PRIORITY_ID)
+        g_result.highLatencyMs.push_back(latencyMs);
+}
+
+
+static void
+QueueDequeue(Ptr<const Packet> p, Time sojourn)
+{
+    g_result.dequeued++;
+    g_result.sojournSumMs += sojourn.GetSeconds() * 1e3;
+    g_result.sojournMaxMs = std::max(g_result.sojournMaxMs, sojourn.GetSeconds() * 1e3);
+}
+
+
+static void
+QueueDrop(Ptr<const Packet> p, LrWpanTxQueue::DropReason reason)
+{
+    g_result.dropped++;
+}
+
+
+/// @brief 메시지 하나를 만들어 큐(없으면 MAC)에 넘깁니다.
+/// @param sender 송신 디바이스 핸들
+/// @param queue 송신 큐, nullptr이면 MAC에 바로 넘김
+/// @param period 생성 간격
+/// @param end 생성을 멈출 시각
+static void
+Generate(LrWpanHandles sender, Ptr<LrWpanTxQueue> queue, Time period, Time end)
+{
+    // 10개 중 1개는 높은 우선순위
+    uint32_t messageId = g_result.generated % 10 == 0 ? HIGH_PRIORITY_ID : LOW_PRIORITY_ID;
+    g_result.generated++;
+
+    QueuePayload payload = {Simulator::Now().GetNanoSeconds(), messageId};
+    Ptr<Packet> packet = Create<Packet>(reinterpret_cast<const uint8_t*>(&payload), sizeof(payload));
+    McpsDataRequestParams params =
+        CreateMcpsDataRequestParams(Mac16Address("00:01"), COORDINATOR_PAN_ID, SHORT_ADDR, TX_OPTION_ACK);
+
+    if(queue)
+        queue->Enqueue(params, packet, messageId);
+    else
+        sender.mac->McpsDataRequest(params, packet);
+
+    if(Simulator::Now() + period < end)
+        Simulator::Schedule(period, &Generate, sender, queue, period, end);
+}
+
+
+static double
+Percentile(std::vector<double> values, double p)
+{
+    if(values.empty())
+        return 0;
+    std::sort(values.begin(), values.end());
+    return values[std::min<size_t>(values.size() - 1, values.size() * p)];
+}
+
+
+static double
+Mean(const std::vector<double>& values)
+{
+    double sum = 0;
+    for(double v : values)
+        sum += v;
+    return values.empty() ? 0 : sum / values.size();
+}
+
+
+/// @brief 과부하 시나리오를 한 번 실행합니다.
+/// @param mode unbounded, droptail, dropoldest, priority, deadline
+static QueueResult
+RunQueue(const std::string& mode, Time period, Time duration, uint32_t queueSize, Time maxDelay)
+{
+    g_result = QueueResult();
+
+    NodeContainer pan;
+    pan.Create(2);
+
+    MobilityHelper mobilityHelper;
+    mobilityHelper.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+    mobilityHelper.SetPositionAllocator("ns3::GridPositionAllocator",
+                                        "DeltaX", DoubleValue(10.0),
+                                        "GridWidth", UintegerValue(2));
+    mobilityHelper.Install(pan);
+
+    LrWpanHelper lrWpanHelper;
+    NetDeviceContainer netDevices = lrWpanHelper.Install(pan);
+    lrWpanHelper.CreateAssociatedPan(netDevices, COORDINATOR_PAN_ID);
+
+    LrWpanDeviceTable table(netDevices);
+    table[0].mac->SetMcpsDataIndicationCallback(MakeCallback(&McpsDataIndication));
+
+    Ptr<LrWpanTxQueue> queue;
+    if(mode != "unbounded")
+    {
+        queue = CreateObject<LrWpanTxQueue>();
+        queue->SetAttribute("MaxSize", UintegerValue(queueSize));
+        if(mode == "dropoldest")
+            queue->SetAttribute("DropPolicy", EnumValue(LrWpanTxQueue::DROP_OLDEST));
+        else if(mode == "priority")
+            queue->SetAttribute("DropPolicy", EnumValue(LrWpanTxQueue::PRIORITY));
+        else if(mode == "deadline")
+            queue->SetAttribute("MaxDelay", TimeValue(maxDelay));
+
+        queue->TraceConnectWithoutContext("Dequeue", MakeCallback(&QueueDequeue));
+        queue->TraceConnectWithoutContext("Drop", MakeCallback(&QueueDrop));
+        queue->Install(table[1]);
+    }
+
+    Time start = Seconds(0.1);
+    Simulator::ScheduleWithContext(table[1].nodeId, start, &Generate, table[1], queue, period, start + duration);
+    Simulator::Stop(start + duration + Seconds(1));
+    Simulator::Run();
+    Simulator::Destroy();
+
+    return g_result;
+}
+
+
+int main(int argc, char* argv[])
+{
+    std::string modes = "unbounded,droptail,dropoldest,priority,deadline";
+    double periodMs = 1;
+    double duration = 5;
+    uint32_t queueSize = 8;
+    double maxDelayMs = 50;
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("modes", "쉼표로 구분한 실행 모드 목록", modes);
+    cmd.AddValue("period", "메시지 생성 간격(ms)", periodMs);
+    cmd.AddValue("duration", "메시지를 생성하는 시간(s)", duration);
+    cmd.AddValue("queueSize", "송신 큐 크기", queueSize);
+    cmd.AddValue("maxDelay", "deadline 모드의 MaxDelay(ms)", maxDelayMs);
+    cmd.Parse(argc, argv);
+
+    std::cout
+        << std::left
+        << std::setw(12) << "mode"
+        << std::setw(11) << "generated"
+        << std::setw(11) << "delivered"
+        << std::setw(9) << "dropped"
+        << std::setw(13) << "avg lat(ms)"
+        << std::setw(13) << "p99 lat(ms)"
+        << std::setw(15) << "high avg(ms)"
+        << std::setw(15) << "avg queue(ms)"
+        << "max queue(ms)"
+        << std::endl
+    ;
+
+    std::stringstream ss(modes);
+    std::string mode;
+    while(std::getline(ss, mode, ','))
+    {
+        QueueResult result =
+            RunQueue(mode, Seconds(periodMs / 1e3), Seconds(duration), queueSize, Seconds(maxDelayMs / 1e3));
+
+        std::cout
+            << std::left
+            << std::setw(12) << mode
+            << std::setw(11) << result.generated
+            << std::setw(11) << result.latencyMs.size()
+            << std::setw(9) << result.dropped
+            << std::fixed << std::setprecision(2)
+            << std::setw(13) << Mean(result.latencyMs)
+            << std::setw(13) << Percentile(result.latencyMs, 0.99)
+            << std::setw(15) << Mean(result.highLatencyMs)
+            << std::setw(15) << (result.dequeued ? result.sojournSumMs / result.dequeued : 0)
+            << result.sojournMaxMs
+            << std::endl
+        ;
+    }
+
+    return 0;
+}